@@ -0,0 +1,86 @@
+/**
+ * Copyright (c) 2017-present, Status Research and Development GmbH.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ *
+ * @providesModule QtHostModules
+ * @flow
+ */
+
+'use strict';
+
+const BatchedBridge = require('BatchedBridge');
+const NativeModules = require('NativeModules');
+
+// With the JavaScriptCore executor, every native module is also exposed as a
+// host object whose methods call into the module directly. Async and promise
+// methods of NativeModules are rebound to them in place, so calls skip the JSON
+// round trip. Native side runs them from the same queue as batched calls.
+// Sync methods return a value the host objects can't give, they keep using the queue.
+const hostModules = global.__qtNativeModules;
+
+function createErrorFromErrorData(errorData: {message: string}): Error {
+  const {message, ...extraErrorInfo} = errorData || {};
+  const error = new Error(message);
+  // $FlowFixMe
+  return Object.assign(error, extraErrorInfo);
+}
+
+// Calls batched so far go to native before a host object call, the same way
+// MessageQueue flushes a batch early, so they keep the order they were made in
+function flushBatch() {
+  const queue = BatchedBridge._queue;
+  if (queue[0].length === 0 || !global.nativeFlushQueueImmediate) {
+    return;
+  }
+  BatchedBridge._queue = [[], [], [], BatchedBridge._callID];
+  BatchedBridge._lastFlush = Date.now();
+  global.nativeFlushQueueImmediate(queue);
+}
+
+function bindToHostModule(module: Object, hostModule: Object) {
+  Object.keys(module).forEach(methodName => {
+    const method = module[methodName];
+    const hostMethod = hostModule[methodName];
+    if (typeof method !== 'function' || typeof hostMethod !== 'function') {
+      return;
+    }
+
+    let fn = null;
+    if (method.type === 'promise') {
+      fn = function(...args: Array<any>) {
+        return new Promise((resolve, reject) => {
+          flushBatch();
+          hostMethod(...args, resolve, errorData =>
+            reject(createErrorFromErrorData(errorData)),
+          );
+        });
+      };
+    } else if (method.type === 'async') {
+      // Callbacks are passed on as functions, host objects keep them alive while native holds them
+      fn = function(...args: Array<any>) {
+        flushBatch();
+        hostMethod(...args);
+      };
+    }
+
+    if (fn) {
+      fn.type = method.type;
+      module[methodName] = fn;
+    }
+  });
+}
+
+if (hostModules) {
+  Object.keys(hostModules).forEach(moduleName => {
+    const module = NativeModules[moduleName];
+    if (module) {
+      bindToHostModule(module, hostModules[moduleName]);
+    }
+  });
+}
+
+module.exports = NativeModules;
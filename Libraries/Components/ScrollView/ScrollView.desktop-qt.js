@@ -17,6 +17,7 @@ const ReactNative = require('../../Renderer/shims/ReactNative');
 const ScrollResponder = require('../ScrollResponder');
 const ScrollViewStickyHeader = require('./ScrollViewStickyHeader');
 const StyleSheet = require('../../StyleSheet/StyleSheet');
+const UIManager = require('../../ReactNative/UIManager');
 const View = require('../View/View');
 
 const dismissKeyboard = require('../../Utilities/dismissKeyboard');
@@ -464,6 +465,28 @@ export type Props = $ReadOnly<{|
    * or begins to glide.
    */
   onScrollEndDrag?: (event: ScrollEvent) => void,
+  /**
+   * Called when the range of rows shown by a scroll view with
+   * `enableArrayScrollingOptimization` changes. The event has the indices
+   * of the `first` and `last` visible rows, the `windowFirst` and
+   * `windowLast` rows kept laid out around them and the row `count`.
+   * Rows outside the window can be unmounted or replaced by placeholders.
+   * @platform desktop-qt
+   */
+  onVisibleRangeChange?: ?Function,
+  /**
+   * With `enableArrayScrollingOptimization`, lays out only the visible rows
+   * and `overscanRowCount` rows before and after them. Other rows keep their
+   * last size until they are scrolled into the window again.
+   * @platform desktop-qt
+   */
+  windowed?: ?boolean,
+  /**
+   * Rows kept laid out on each side of the visible ones in `windowed` mode,
+   * 10 by default.
+   * @platform desktop-qt
+   */
+  overscanRowCount?: ?number,
   /**
    * Called when scrollable content view of the ScrollView changes.
    *
@@ -798,6 +821,37 @@ class ScrollView extends React.Component<Props, State> {
     });
   }
 
+  /**
+   * Drives `property` of `view` by the scroll offset natively, without a
+   * round trip to JS per frame. `property` is one of `opacity`, `scale`,
+   * `rotate` (in degrees), `translateX` or `translateY`. `config` is that of
+   * `Animated.Value#interpolate()`, mapping the offset along `config.axis`,
+   * `'x'` or `'y'` (the default), to the value of the property.
+   *
+   * @platform desktop-qt
+   */
+  bindScrollProperty(view: any, property: string, config: Object) {
+    UIManager.dispatchViewManagerCommand(
+      this.getScrollableNode(),
+      UIManager.RCTScrollView.Commands.bindScrollProperty,
+      [ReactNative.findNodeHandle(view), property, config],
+    );
+  }
+
+  /**
+   * Stops driving `property` of `view` by the scroll offset and restores the
+   * value it had before it was bound.
+   *
+   * @platform desktop-qt
+   */
+  unbindScrollProperty(view: any, property: string) {
+    UIManager.dispatchViewManagerCommand(
+      this.getScrollableNode(),
+      UIManager.RCTScrollView.Commands.unbindScrollProperty,
+      [ReactNative.findNodeHandle(view), property],
+    );
+  }
+
   /**
    * Deprecated, use `scrollTo` instead.
    */
@@ -13,6 +13,9 @@
 'use strict';
 
 const NativeModules = require('NativeModules');
+// Required by nearly every module at startup, so it rebinds NativeModules
+// to the JavaScriptCore host objects before they are used
+require('QtHostModules');
 
 var Platform = {
   OS: 'desktop-qt',
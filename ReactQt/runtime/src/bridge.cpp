@@ -45,6 +45,7 @@
 #include "moduleinterface.h"
 #include "moduleloader.h"
 #include "modulemethod.h"
+#include "nativeanimatedmodule.h"
 #include "netinfo.h"
 #include "networking.h"
 #include "platform.h"
@@ -61,12 +62,15 @@
 #include "jscutilities.h"
 #endif
 
+#include <QAtomicInt>
 #include <QDir>
 #include <QJsonDocument>
 #include <QMap>
+#include <QMutex>
 #include <QNetworkAccessManager>
 #include <QNetworkDiskCache>
 #include <QPluginLoader>
+#include <QPointer>
 #include <QQuickItem>
 #include <QStandardPaths>
 #include <QThread>
@@ -88,6 +92,7 @@ public:
     SourceCode* sourceCode = nullptr;
     EventDispatcher* eventDispatcher = nullptr;
     TestModule* reactTestModule = nullptr;
+    NativeAnimatedModule* nativeAnimatedModule = nullptr;
     QUrl bundleUrl;
     QString pluginsPath = "./plugins";
     QMap<int, ModuleData*> modules;
@@ -95,6 +100,25 @@ public:
     bool hotReload = false;
     QVariantList externalModules;
     QThread* executorThread = nullptr;
+    int viewIncubationBudget = 0;
+    std::shared_ptr<YGConfig> yogaConfig = std::shared_ptr<YGConfig>(YGConfigNew(), YGConfigFree);
+    float pointScaleFactor = 1;
+    QStringList yogaExperimentalFeatures;
+    bool yogaUseWebDefaults = false;
+    // Executors may run the callbacks of calls on their own thread
+    QAtomicInt jsCallsInFlight;
+
+    // Batched calls are looked up by ids when they run, direct calls carry their method
+    struct NativeCall {
+        int moduleId;
+        int methodId;
+        QPointer<ModuleMethod> method;
+        QVariantList args;
+    };
+    QMutex nativeCallsMutex;
+    QList<NativeCall> nativeCalls;
+    bool nativeCallsFlushScheduled = false;
+    bool flushingNativeCalls = false;
 
     bool useJSC = false;
 
@@ -223,6 +247,11 @@ void Bridge::resetExecutor() {
         d->executor = nullptr;
         d->useJSC = false;
     }
+    // Calls to the old executor won't return
+    d->jsCallsInFlight = 0;
+
+    QMutexLocker locker(&d->nativeCallsMutex);
+    d->nativeCalls.clear();
 }
 
 void Bridge::init() {
@@ -269,13 +298,23 @@ void Bridge::enqueueJSCall(const QString& module, const QString& method, const Q
     if (!d_func()->executor)
         return;
     QVariantList list = QVariantList{module, method, args};
+    d_func()->jsCallsInFlight.ref();
     QMetaObject::invokeMethod(
         d_func()->executor,
         "executeJSCall",
         Qt::AutoConnection,
         Q_ARG(const QString&, "callFunctionReturnFlushedQueue"),
         Q_ARG(const QVariantList&, list),
-        Q_ARG(const IJsExecutor::ExecuteCallback&, [=](const QJsonDocument& doc) { processResult(doc); }));
+        Q_ARG(const IJsExecutor::ExecuteCallback&, [=](const QJsonDocument& doc) {
+            d_func()->jsCallsInFlight.deref();
+            processResult(doc);
+            emit jsCallReturned();
+        }));
+}
+
+int Bridge::jsCallsInFlight() const {
+    // Returns of calls made before an executor reset may still arrive
+    return qMax(0, d_func()->jsCallsInFlight.load());
 }
 
 void Bridge::invokePromiseCallback(double callbackCode, const QVariantList& args) {
@@ -427,6 +466,74 @@ void Bridge::setJsExecutor(const QString& jsExecutor) {
     d->jsExecutor = jsExecutor;
 }
 
+int Bridge::viewIncubationBudget() const {
+    return d_func()->viewIncubationBudget;
+}
+
+std::shared_ptr<YGConfig> Bridge::yogaConfig() const {
+    return d_func()->yogaConfig;
+}
+
+float Bridge::pointScaleFactor() const {
+    return d_func()->pointScaleFactor;
+}
+
+void Bridge::setPointScaleFactor(float pointScaleFactor) {
+    Q_D(Bridge);
+    if (qFuzzyCompare(d->pointScaleFactor, pointScaleFactor))
+        return;
+    d->pointScaleFactor = pointScaleFactor;
+
+    YGConfigSetPointScaleFactor(d->yogaConfig.get(), pointScaleFactor);
+    if (visualParent()) {
+        visualParent()->invalidateLayout();
+    }
+}
+
+QStringList Bridge::yogaExperimentalFeatures() const {
+    return d_func()->yogaExperimentalFeatures;
+}
+
+void Bridge::setYogaExperimentalFeatures(const QStringList& features) {
+    Q_D(Bridge);
+    if (d->yogaExperimentalFeatures == features)
+        return;
+    d->yogaExperimentalFeatures = features;
+
+    for (int i = 0; i < YGExperimentalFeatureCount; ++i) {
+        YGExperimentalFeature feature = static_cast<YGExperimentalFeature>(i);
+        YGConfigSetExperimentalFeatureEnabled(
+            d->yogaConfig.get(), feature, features.contains(YGExperimentalFeatureToString(feature)));
+    }
+    if (visualParent()) {
+        visualParent()->invalidateLayout();
+    }
+}
+
+bool Bridge::yogaUseWebDefaults() const {
+    return d_func()->yogaUseWebDefaults;
+}
+
+void Bridge::setYogaUseWebDefaults(bool useWebDefaults) {
+    Q_D(Bridge);
+    if (d->yogaUseWebDefaults == useWebDefaults)
+        return;
+    d->yogaUseWebDefaults = useWebDefaults;
+
+    YGConfigSetUseWebDefaults(d->yogaConfig.get(), useWebDefaults);
+    if (visualParent()) {
+        visualParent()->invalidateLayout();
+    }
+}
+
+void Bridge::setViewIncubationBudget(int msecs) {
+    Q_D(Bridge);
+    d->viewIncubationBudget = msecs;
+    if (d->uiManager) {
+        d->uiManager->setIncubationBudget(msecs);
+    }
+}
+
 QString Bridge::serverConnectionType() const {
     return d_func()->serverConnectionType;
 }
@@ -463,6 +570,10 @@ TestModule* Bridge::testModule() const {
     return d_func()->reactTestModule;
 }
 
+NativeAnimatedModule* Bridge::nativeAnimatedModule() const {
+    return d_func()->nativeAnimatedModule;
+}
+
 ImageLoader* Bridge::imageLoader() const {
     return d_func()->imageLoader;
 }
@@ -537,6 +648,8 @@ void Bridge::initModules() {
     modules << d->imageLoader;
     d->reactTestModule = new TestModule;
     modules << d->reactTestModule;
+    d->nativeAnimatedModule = new NativeAnimatedModule;
+    modules << d->nativeAnimatedModule;
 
     // XXX:
     d->sourceCode->setScriptUrl(d->bundleUrl);
@@ -553,6 +666,7 @@ void Bridge::initModules() {
     // Setup of UIManager should be in the end,
     // since it exposes all view managers data to JS as constants of itself
     d->uiManager = new UIManager;
+    d->uiManager->setIncubationBudget(d->viewIncubationBudget);
     addModuleData(d->uiManager);
 }
 
@@ -612,14 +726,6 @@ void Bridge::injectModules() {
 }
 
 void Bridge::processResult(const QJsonDocument& doc) {
-
-    // If executor is threaded, we shouldn't call modules directly because they will be invoked on executor thread!
-    QMetaObject::invokeMethod(this, "passCallsToNativeModules", Qt::AutoConnection, Q_ARG(QJsonDocument, doc));
-}
-
-void Bridge::passCallsToNativeModules(const QJsonDocument& doc) {
-    Q_D(Bridge);
-
     if (doc.isNull())
         return;
 
@@ -628,20 +734,76 @@ void Bridge::passCallsToNativeModules(const QJsonDocument& doc) {
         return;
     }
 
-    QVariantList requests = doc.toVariant().toList();
+    // If executor is threaded, we shouldn't call modules directly because they will be invoked on executor thread!
+    enqueueNativeCalls(doc.toVariant().toList());
+}
+
+void Bridge::enqueueNativeCalls(const QVariantList& requests) {
+    Q_D(Bridge);
+
+    QVariantList moduleIDs = requests.value(FieldRequestModuleIDs).toList();
+    QVariantList methodIDs = requests.value(FieldMethodIDs).toList();
+    QVariantList paramArrays = requests.value(FieldParams).toList();
+
+    bool scheduleFlush = false;
+    {
+        QMutexLocker locker(&d->nativeCallsMutex);
+        // XXX: this should all really be wrapped up in a Module class
+        // including invocations etc
+        for (int i = 0; i < moduleIDs.size(); ++i) {
+            d->nativeCalls.push_back({moduleIDs[i].toInt(), methodIDs[i].toInt(), nullptr, paramArrays[i].toList()});
+        }
+        scheduleFlush = !d->nativeCallsFlushScheduled;
+        d->nativeCallsFlushScheduled = true;
+    }
+    // Batches returned on the bridge's thread run right away, as they always did
+    if (scheduleFlush)
+        QMetaObject::invokeMethod(this, "flushNativeCalls", Qt::AutoConnection);
+}
+
+void Bridge::enqueueNativeCall(ModuleMethod* method, const QVariantList& args) {
+    Q_D(Bridge);
+
+    QMutexLocker locker(&d->nativeCallsMutex);
+    d->nativeCalls.push_back({-1, -1, method, args});
+    if (!d->nativeCallsFlushScheduled) {
+        d->nativeCallsFlushScheduled = true;
+        QMetaObject::invokeMethod(this, "flushNativeCalls", Qt::QueuedConnection);
+    }
+}
 
-    QVariantList moduleIDs = requests[FieldRequestModuleIDs].toList();
-    QVariantList methodIDs = requests[FieldMethodIDs].toList();
-    QVariantList paramArrays = requests[FieldParams].toList();
+void Bridge::flushNativeCalls() {
+    Q_D(Bridge);
 
-    // XXX: this should all really be wrapped up in a Module class
-    // including invocations etc
-    for (int i = 0; i < moduleIDs.size(); ++i) {
-        invokeModuleMethod(moduleIDs[i].toInt(), methodIDs[i].toInt(), paramArrays[i].toList());
+    // Calls enqueued by the running ones are picked up by the outer flush, after the calls before them
+    if (d->flushingNativeCalls)
+        return;
+    d->flushingNativeCalls = true;
+
+    forever {
+        QList<BridgePrivate::NativeCall> calls;
+        {
+            QMutexLocker locker(&d->nativeCallsMutex);
+            d->nativeCallsFlushScheduled = false;
+            calls.swap(d->nativeCalls);
+        }
+        if (calls.isEmpty())
+            break;
+
+        for (const BridgePrivate::NativeCall& call : calls) {
+            if (call.moduleId >= 0) {
+                invokeModuleMethod(call.moduleId, call.methodId, call.args);
+            } else if (call.method) {
+                call.method->invoke(call.args);
+            }
+        }
     }
 
-    auto parent = qobject_cast<RootView*>(visualParent());
-    parent->recalculateLayout();
+    d->flushingNativeCalls = false;
+
+    // Layout requests of all calls are coalesced by the root view until the next frame
+    if (auto parent = qobject_cast<RootView*>(visualParent()))
+        parent->recalculateLayout();
 }
 
 void Bridge::invokeModuleMethod(int moduleId, int methodId, QList<QVariant> args) {
@@ -16,19 +16,24 @@
 
 #include <QObject>
 #include <QScopedPointer>
+#include <QStringList>
 #include <QUrl>
 
 #include <functional>
+#include <memory>
 
+struct YGConfig;
 class QQuickItem;
 class QQmlEngine;
 class QNetworkAccessManager;
 class ModuleData;
+class ModuleMethod;
 class UIManager;
 class ImageLoader;
 class EventDispatcher;
 class Redbox;
 class TestModule;
+class NativeAnimatedModule;
 class ModuleInterface;
 class RootView;
 
@@ -63,6 +68,8 @@ public:
 
     void invokePromiseCallback(double callbackCode, const QVariantList& args);
     void enqueueJSCall(const QString& module, const QString& method, const QVariantList& args);
+    // Calls enqueued by enqueueJSCall() which JS hasn't returned from yet, a measure of how backed up the bridge is
+    int jsCallsInFlight() const;
     void invokeAndProcess(const QString& method, const QVariantList& args);
     void executeSourceCode(const QByteArray& sourceCode);
     void enqueueRunAppCall(const QVariantList& args);
@@ -99,10 +106,28 @@ public:
     const QVariantList& externalModules() const;
     void setExternalModules(const QVariantList& externalModules);
 
+    // Per frame time budget in msecs for creating QML based views asynchronously, 0 disables it
+    int viewIncubationBudget() const;
+    void setViewIncubationBudget(int msecs);
+
+    // Yoga config of the layout nodes of all views created by this bridge
+    std::shared_ptr<YGConfig> yogaConfig() const;
+    // Layout is rounded to the physical pixel grid, usually the device pixel ratio
+    float pointScaleFactor() const;
+    void setPointScaleFactor(float pointScaleFactor);
+    // Names as returned by YGExperimentalFeatureToString(), e.g. "web-flex-basis"
+    QStringList yogaExperimentalFeatures() const;
+    void setYogaExperimentalFeatures(const QStringList& features);
+    // Yoga's web defaults: row direction, stretched content and shrinking items. Style defaults only reach
+    // nodes which get the config afterwards, so it should be set before the bundle is loaded.
+    bool yogaUseWebDefaults() const;
+    void setYogaUseWebDefaults(bool useWebDefaults);
+
     EventDispatcher* eventDispatcher() const;
     QList<ModuleData*> modules() const;
     UIManager* uiManager() const;
     TestModule* testModule() const;
+    NativeAnimatedModule* nativeAnimatedModule() const;
     ImageLoader* imageLoader() const;
     Redbox* redbox();
 
@@ -116,18 +141,25 @@ public:
     void* getJavaScriptContext();
     void executeOnJavaScriptThread(std::function<void()> func);
 
+    // Native calls from batches flushed by the js MessageQueue and from JavaScriptCore host objects
+    // share one queue, they run on the bridge's thread in the order they were enqueued. Thread safe.
+    void enqueueNativeCalls(const QVariantList& requests);
+    void enqueueNativeCall(ModuleMethod* method, const QVariantList& args);
+
     void loadSource();
     void initModules();
 
 Q_SIGNALS:
     void readyChanged();
     void jsAppStartedChanged();
+    // Emitted from the executor's thread when a call made by enqueueJSCall() has returned
+    void jsCallReturned();
 
 private Q_SLOTS:
     void sourcesFinished();
     void sourcesLoadFailed();
     void applicationScriptDone();
-    void passCallsToNativeModules(const QJsonDocument& doc);
+    void flushNativeCalls();
 
 private:
     void loadExternalModules(QObjectList* modules);
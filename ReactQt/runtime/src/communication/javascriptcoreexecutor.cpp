@@ -14,6 +14,7 @@
 #include "javascriptcoreexecutor.h"
 
 #include "bridge.h"
+#include "jscmodulebindings.h"
 #include "jscutilities.h"
 
 #include "cxxreact/Instance.h"
@@ -199,6 +200,8 @@ void JavaScriptCoreExecutor::init() {
     d->_jsMessageThread->runOnQueue([=] {
         d->_reactInstance->initializeBridge(
             std::make_unique<RCTInstanceCallback>(d->bridge), executorFactory, d->_jsMessageThread, moduleRegistry);
+        utilities::installModuleBindings(
+            static_cast<JSGlobalContextRef>(d->_reactInstance->getJavaScriptContext()), d->bridge);
     });
 
     QTimer::singleShot(500, [=]() { d->bridge->loadSource(); });
@@ -113,7 +113,12 @@ void ComponentData::attachReactProperties(QQuickItem* view, int tag) {
     rap->setTag(tag);
     rap->setShouldLayout(viewManager->shouldLayout());
     rap->setViewManager(viewManager);
-    rap->setPropertyHandler(m_moduleInterface->propertyHandler(view));
+    // Recycled views keep the handler they were created with
+    if (rap->propertyHandler() == nullptr) {
+        rap->setPropertyHandler(m_moduleInterface->propertyHandler(view));
+    }
+    // Only views which go back to a pool get their props reset
+    rap->propertyHandler()->setTracksAppliedProperties(viewManager->canRecycleView(view));
 }
 
 QQuickItem* ComponentData::createView(int tag, const QVariantMap& properties) {
@@ -122,6 +127,17 @@ QQuickItem* ComponentData::createView(int tag, const QVariantMap& properties) {
     return view;
 }
 
+void ComponentData::incubateView(int tag,
+                                 const QVariantMap& properties,
+                                 const std::function<void(QQuickItem*)>& callback) {
+    m_moduleInterface->viewManager()->incubateView(properties, [=](QQuickItem* view) {
+        if (view) {
+            attachReactProperties(view, tag);
+        }
+        callback(view);
+    });
+}
+
 ModuleMethod* ComponentData::method(int id) const {
     return m_moduleData->method(id);
 }
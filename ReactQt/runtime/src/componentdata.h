@@ -17,6 +17,8 @@
 #include <QString>
 #include <QVariant>
 
+#include <functional>
+
 class QQuickItem;
 class ModuleData;
 class ViewManager;
@@ -34,6 +36,7 @@ public:
     QVariantMap viewConfig() const;
 
     QQuickItem* createView(int tag, const QVariantMap& properties);
+    void incubateView(int tag, const QVariantMap& properties, const std::function<void(QQuickItem*)>& callback);
 
     ModuleMethod* method(int id) const;
 
@@ -23,6 +23,7 @@
 #include "bridge.h"
 #include "imageloader.h"
 #include "imagemanager.h"
+#include "propertycache.h"
 #include "propertyhandler.h"
 #include "utilities.h"
 
@@ -34,6 +35,12 @@ static QMap<ImageLoader::Event, QString> eventNames{{ImageLoader::Event_LoadStar
                                                     {ImageLoader::Event_LoadError, "onError"},
                                                     {ImageLoader::Event_LoadSuccess, "onLoad"},
                                                     {ImageLoader::Event_LoadEnd, "onLoadEnd"}};
+// QML properties telling if js handles the events, static for PropertyCache
+static QMap<ImageLoader::Event, const char*> eventHandlerProperties{{ImageLoader::Event_LoadStart, "p_onLoadStart"},
+                                                                    {ImageLoader::Event_Progress, "p_onProgress"},
+                                                                    {ImageLoader::Event_LoadError, "p_onError"},
+                                                                    {ImageLoader::Event_LoadSuccess, "p_onLoad"},
+                                                                    {ImageLoader::Event_LoadEnd, "p_onLoadEnd"}};
 const QString URI_KEY = QStringLiteral("uri");
 const QString FILE_SCHEME = QStringLiteral("file://");
 } // namespace
@@ -96,8 +103,7 @@ void ImageManager::manageSource(const QVariantList& sourceProp, QQuickItem* imag
         if (event == ImageLoader::Event_LoadSuccess) {
             d->setSource(image, imageSourceUrl);
         }
-        bool eventHandlerSet =
-            image->property(QString(QML_PROPERTY_PREFIX + eventNames[event]).toStdString().c_str()).toBool();
+        bool eventHandlerSet = PropertyCache::read(image, eventHandlerProperties.value(event)).toBool();
         if (eventHandlerSet) {
             notifyJsAboutEvent(tag(image), eventNames[event], data);
         }
@@ -56,6 +56,14 @@ void ModalManager::addChildItem(QQuickItem* modalView, QQuickItem* child, int po
     utilities::insertChildItemAt(child, position, contentItem);
 }
 
+void ModalManager::addChildItems(QQuickItem* modalView,
+                                 const QList<QQuickItem*>& children,
+                                 const QList<int>& positions) const {
+    QQuickItem* contentItem = QQmlProperty(modalView, "contentItem").read().value<QQuickItem*>();
+    Q_ASSERT(contentItem != nullptr);
+    utilities::insertChildItemsAt(children, positions, contentItem);
+}
+
 QStringList ModalManager::customDirectEventTypes() {
     return QStringList{
         normalizeInputEventName(EVENT_ONSHOW),
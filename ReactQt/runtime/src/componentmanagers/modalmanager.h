@@ -30,6 +30,9 @@ public:
     virtual ViewManager* viewManager() override;
     virtual QString moduleName() override;
     void addChildItem(QQuickItem* modalView, QQuickItem* child, int position) const override;
+    void addChildItems(QQuickItem* modalView,
+                       const QList<QQuickItem*>& children,
+                       const QList<int>& positions) const override;
     virtual QStringList customDirectEventTypes() override;
 
 public slots:
@@ -21,6 +21,7 @@
 #include "attachedproperties.h"
 #include "bridge.h"
 #include "navigatormanager.h"
+#include "propertycache.h"
 #include "propertyhandler.h"
 #include "uimanager.h"
 #include "utilities.h"
@@ -75,7 +76,7 @@ QStringList NavigatorManager::customBubblingEventTypes() {
 void NavigatorManager::backTriggered() {
     QQuickItem* viewItem = qobject_cast<QQuickItem*>(sender());
 
-    bool backButtonPressFlagSet = viewItem->property("p_onBackButtonPress").toBool();
+    bool backButtonPressFlagSet = PropertyCache::read(viewItem, "p_onBackButtonPress").toBool();
 
     if (backButtonPressFlagSet) {
         notifyJsAboutEvent(tag(viewItem), "onBackButtonPress", {});
@@ -84,7 +85,7 @@ void NavigatorManager::backTriggered() {
 
 void NavigatorManager::configureView(QQuickItem* view) const {
     ViewManager::configureView(view);
-    connect(view, SIGNAL(backTriggered()), SLOT(backTriggered()));
+    connect(view, SIGNAL(backTriggered()), SLOT(backTriggered()), Qt::UniqueConnection);
 }
 
 QString NavigatorManager::qmlComponentFile(const QVariantMap& properties) const {
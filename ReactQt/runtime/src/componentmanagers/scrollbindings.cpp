@@ -0,0 +1,207 @@
+
+/**
+ * Copyright (c) 2017-present, Status Research and Development GmbH.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "scrollbindings.h"
+#include "propertycache.h"
+
+#include <QMatrix4x4>
+#include <QQmlListReference>
+#include <QQuickItem>
+
+#include <iterator>
+
+class TranslateTransform : public QQuickTransform {
+public:
+    TranslateTransform(QQuickItem* parent) : QQuickTransform(parent) {}
+
+    void applyTo(QMatrix4x4* matrix) const override {
+        matrix->translate(m_x, m_y);
+    }
+
+    void setTranslation(qreal x, qreal y) {
+        if (x == m_x && y == m_y)
+            return;
+        m_x = x;
+        m_y = y;
+        update();
+    }
+
+    qreal m_x = 0;
+    qreal m_y = 0;
+};
+
+namespace {
+
+const QHash<QString, ScrollBindings::Property>& propertiesByName() {
+    static const QHash<QString, ScrollBindings::Property> properties{{"opacity", ScrollBindings::Opacity},
+                                                                     {"scale", ScrollBindings::Scale},
+                                                                     {"rotate", ScrollBindings::Rotate},
+                                                                     {"translateX", ScrollBindings::TranslateX},
+                                                                     {"translateY", ScrollBindings::TranslateY}};
+    return properties;
+}
+
+} // namespace
+
+ScrollBindings::ScrollBindings(QObject* parent) : QObject(parent) {}
+
+ScrollBindings::~ScrollBindings() {}
+
+bool ScrollBindings::bind(QQuickItem* scrollView,
+                          QQuickItem* target,
+                          const QString& property,
+                          const QVariantMap& config) {
+    Q_ASSERT(scrollView && target);
+
+    auto propertyIt = propertiesByName().constFind(property);
+    Interpolation interpolation = Interpolation::fromConfig(config);
+    if (propertyIt == propertiesByName().constEnd() || !interpolation.isValid())
+        return false;
+
+    Binding binding;
+    // A rebound property is restored to its value from before the first binding
+    if (!takeBinding(target, propertyIt.value(), binding)) {
+        binding.target = target;
+        binding.property = propertyIt.value();
+        binding.unboundValue = value(target, binding.property);
+    }
+    binding.horizontal = config.value("axis").toString() == "x";
+    binding.interpolation = interpolation;
+
+    if (!m_bindingsByScrollView.contains(scrollView)) {
+        connect(scrollView, SIGNAL(contentXChanged()), this, SLOT(updateBindings()));
+        connect(scrollView, SIGNAL(contentYChanged()), this, SLOT(updateBindings()));
+        connect(scrollView, &QObject::destroyed, this, &ScrollBindings::removeScrollView);
+    }
+    m_bindingsByScrollView[scrollView].append(binding);
+    apply(scrollView, binding);
+    return true;
+}
+
+void ScrollBindings::unbind(QQuickItem* target, const QString& property) {
+    auto propertyIt = propertiesByName().constFind(property);
+    if (propertyIt == propertiesByName().constEnd())
+        return;
+
+    Binding binding;
+    if (takeBinding(target, propertyIt.value(), binding)) {
+        setValue(target, binding.property, binding.unboundValue);
+    }
+}
+
+bool ScrollBindings::takeBinding(QQuickItem* target, Property property, Binding& binding) {
+    for (auto it = m_bindingsByScrollView.begin(); it != m_bindingsByScrollView.end(); ++it) {
+        QVector<Binding>& bindings = it.value();
+        for (int i = 0; i < bindings.size(); ++i) {
+            if (bindings.at(i).target == target && bindings.at(i).property == property) {
+                binding = bindings.takeAt(i);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void ScrollBindings::updateBindings() {
+    QQuickItem* scrollView = qobject_cast<QQuickItem*>(sender());
+    auto it = m_bindingsByScrollView.find(scrollView);
+    if (it == m_bindingsByScrollView.end())
+        return;
+
+    QVector<Binding>& bindings = it.value();
+    bool targetsDestroyed = false;
+    for (int i = 0; i < bindings.size();) {
+        if (!bindings.at(i).target) {
+            bindings.removeAt(i);
+            targetsDestroyed = true;
+            continue;
+        }
+        apply(scrollView, bindings.at(i));
+        ++i;
+    }
+
+    if (targetsDestroyed) {
+        for (auto transformIt = m_translateTransforms.begin(); transformIt != m_translateTransforms.end();) {
+            transformIt = transformIt.value() ? std::next(transformIt) : m_translateTransforms.erase(transformIt);
+        }
+    }
+}
+
+void ScrollBindings::removeScrollView(QObject* scrollView) {
+    m_bindingsByScrollView.remove(static_cast<QQuickItem*>(scrollView));
+}
+
+void ScrollBindings::apply(QQuickItem* scrollView, const Binding& binding) {
+    // Same offset as in the contentOffset of scroll events
+    const double offset = binding.horizontal ? PropertyCache::read(scrollView, "contentX").toDouble() -
+                                                   PropertyCache::read(scrollView, "originX").toDouble()
+                                             : PropertyCache::read(scrollView, "contentY").toDouble() -
+                                                   PropertyCache::read(scrollView, "originY").toDouble();
+    setValue(binding.target, binding.property, binding.interpolation.evaluate(offset));
+}
+
+double ScrollBindings::value(QQuickItem* target, Property property) const {
+    switch (property) {
+    case Opacity:
+        return target->opacity();
+    case Scale:
+        return target->scale();
+    case Rotate:
+        return target->rotation();
+    case TranslateX:
+    case TranslateY:
+        // Translation of bindings starts at 0, the view's own transform is left as it is
+        return 0;
+    }
+    return 0;
+}
+
+void ScrollBindings::setValue(QQuickItem* target, Property property, double value) {
+    switch (property) {
+    case Opacity:
+        target->setOpacity(value);
+        break;
+    case Scale:
+        target->setScale(value);
+        break;
+    case Rotate:
+        target->setRotation(value);
+        break;
+    case TranslateX:
+    case TranslateY: {
+        TranslateTransform* transform = translateTransform(target);
+        if (property == TranslateX) {
+            transform->setTranslation(value, transform->m_y);
+        } else {
+            transform->setTranslation(transform->m_x, value);
+        }
+        break;
+    }
+    }
+}
+
+TranslateTransform* ScrollBindings::translateTransform(QQuickItem* target) {
+    // Owned by the target, so the pointer is cleared together with it
+    QPointer<QQuickTransform>& transformPtr = m_translateTransforms[target];
+    if (!transformPtr) {
+        transformPtr = new TranslateTransform(target);
+    }
+    TranslateTransform* transform = static_cast<TranslateTransform*>(transformPtr.data());
+
+    // Setting the transform prop from js clears the item's transform list
+    QQmlListReference transforms(target, "transform");
+    for (int i = 0; i < transforms.count(); ++i) {
+        if (transforms.at(i) == transform)
+            return transform;
+    }
+    transforms.append(transform);
+    return transform;
+}
@@ -0,0 +1,67 @@
+
+/**
+ * Copyright (c) 2017-present, Status Research and Development GmbH.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#ifndef SCROLLBINDINGS_H
+#define SCROLLBINDINGS_H
+
+#include "interpolation.h"
+
+#include <QHash>
+#include <QObject>
+#include <QPointer>
+#include <QVector>
+
+class QQuickItem;
+class QQuickTransform;
+class TranslateTransform;
+
+// Properties of views driven by the content offset of a scroll view. Bindings are evaluated natively
+// whenever the scroll view moves, so scroll linked effects like collapsing headers don't wait for js.
+class ScrollBindings : public QObject {
+    Q_OBJECT
+
+public:
+    enum Property { Opacity, Scale, Rotate, TranslateX, TranslateY };
+
+    ScrollBindings(QObject* parent = nullptr);
+    ~ScrollBindings();
+
+    // Property is "opacity", "scale", "rotate" (in degrees), "translateX" or "translateY". Config is that
+    // of Animated's interpolate(), mapping the offset along "axis", "x" or "y" (the default), to the value.
+    // Replaces a binding of the same property of target. Returns false for unknown properties or ranges.
+    bool bind(QQuickItem* scrollView, QQuickItem* target, const QString& property, const QVariantMap& config);
+    // Restores the value the property had before it was bound
+    void unbind(QQuickItem* target, const QString& property);
+
+private Q_SLOTS:
+    void updateBindings();
+    void removeScrollView(QObject* scrollView);
+
+private:
+    struct Binding {
+        QPointer<QQuickItem> target;
+        Property property;
+        bool horizontal = false;
+        Interpolation interpolation;
+        double unboundValue = 0;
+    };
+
+    bool takeBinding(QQuickItem* target, Property property, Binding& binding);
+    void apply(QQuickItem* scrollView, const Binding& binding);
+    double value(QQuickItem* target, Property property) const;
+    void setValue(QQuickItem* target, Property property, double value);
+    TranslateTransform* translateTransform(QQuickItem* target);
+
+    QHash<QQuickItem*, QVector<Binding>> m_bindingsByScrollView;
+    QHash<QQuickItem*, QPointer<QQuickTransform>> m_translateTransforms;
+};
+
+#endif // SCROLLBINDINGS_H
@@ -13,6 +13,7 @@
 
 #include <QQmlComponent>
 #include <QQuickItem>
+#include <QQuickWindow>
 #include <QSet>
 #include <QString>
 #include <QVariant>
@@ -24,6 +25,8 @@
 #include "attachedproperties.h"
 #include "bridge.h"
 #include "layout/flexbox.h"
+#include "nativeanimatedmodule.h"
+#include "propertycache.h"
 #include "propertyhandler.h"
 #include "reactitem.h"
 #include "scrollviewmanager.h"
@@ -34,7 +37,12 @@ using namespace utilities;
 
 QMap<QQuickItem*, QQuickItem*> ScrollViewManager::m_scrollViewByListViewItem;
 QMap<QQuickItem*, ScrollViewModelPtr> ScrollViewManager::m_modelByScrollView;
-QMap<QQuickItem*, QTimer*> ScrollViewManager::m_scrollTimers;
+
+namespace {
+// Scroll events wait for the bridge while it has more calls than this to return from
+const int MAX_JS_CALLS_IN_FLIGHT = 4;
+const QString SCROLL_EVENT_NAME = QStringLiteral("topScroll");
+} // namespace
 
 void ScrollViewManager::scrollTo(int reactTag, double offsetX, double offsetY, bool animated) {
     QQuickItem* item = bridge()->uiManager()->viewForTag(reactTag);
@@ -61,7 +69,38 @@ void ScrollViewManager::scrollToEnd(int reactTag, bool animated) {
     }
 }
 
-ScrollViewManager::ScrollViewManager(QObject* parent) : ViewManager(parent) {}
+void ScrollViewManager::bindScrollProperty(int reactTag,
+                                           int viewTag,
+                                           const QString& property,
+                                           const QVariantMap& config) {
+    QQuickItem* item = bridge()->uiManager()->viewForTag(reactTag);
+    Q_ASSERT(item != nullptr);
+    QQuickItem* view = bridge()->uiManager()->viewForTag(viewTag);
+    if (!view) {
+        qCWarning(VIEWMANAGER) << __PRETTY_FUNCTION__ << "Attempting to bind unknown view" << viewTag;
+        return;
+    }
+
+    if (!m_scrollBindings->bind(item, view, property, config)) {
+        qCWarning(VIEWMANAGER) << __PRETTY_FUNCTION__ << "Unable to bind" << property << "to scrolling with"
+                               << config;
+    }
+}
+
+void ScrollViewManager::unbindScrollProperty(int reactTag, int viewTag, const QString& property) {
+    Q_UNUSED(reactTag)
+    QQuickItem* view = bridge()->uiManager()->viewForTag(viewTag);
+    if (view) {
+        m_scrollBindings->unbind(view, property);
+    }
+}
+
+ScrollViewManager::ScrollViewManager(QObject* parent)
+    : ViewManager(parent), m_scrollThrottleTimer(new QTimer(this)), m_scrollBindings(new ScrollBindings(this)) {
+    m_scrollEventClock.start();
+    m_scrollThrottleTimer->setSingleShot(true);
+    connect(m_scrollThrottleTimer, &QTimer::timeout, this, &ScrollViewManager::sendScrollEvents);
+}
 
 ScrollViewManager::~ScrollViewManager() {}
 
@@ -79,21 +118,26 @@ QStringList ScrollViewManager::customDirectEventTypes() {
                        normalizeInputEventName("scrollEndDrag"),
                        normalizeInputEventName("scrollAnimationEnd"),
                        normalizeInputEventName("momentumScrollBegin"),
-                       normalizeInputEventName("momentumScrollEnd")};
+                       normalizeInputEventName("momentumScrollEnd"),
+                       normalizeInputEventName("onVisibleRangeChange")};
 }
 
 bool ScrollViewManager::isArrayScrollingOptimizationEnabled(QQuickItem* item) {
     return m_scrollViewByListViewItem.contains(item);
 }
 
-void ScrollViewManager::updateListViewItem(QQuickItem* item, QQuickItem* child, int position) {
+void ScrollViewManager::insertListViewItems(QQuickItem* item,
+                                            const QList<QQuickItem*>& children,
+                                            const QList<int>& positions) {
     QQuickItem* scrollView = m_scrollViewByListViewItem[item];
     ScrollViewModelPtr model = m_modelByScrollView[scrollView];
-    model->insert(child, position);
-    QQmlProperty::write(scrollView, "model", QVariant::fromValue(model.data()));
+    // The list view follows the model's row signals, it is assigned the model only once
+    model->insert(children, positions);
 }
 
-QList<QQuickItem*> ScrollViewManager::removeListViewItems(QQuickItem* item, const QList<int>& removeAtIndices) {
+QList<QQuickItem*> ScrollViewManager::removeListViewItems(QQuickItem* item,
+                                                          const QList<int>& removeAtIndices,
+                                                          bool removeFlexboxChilds) {
 
     QList<QQuickItem*> removedChildren;
 
@@ -103,13 +147,14 @@ QList<QQuickItem*> ScrollViewManager::removeListViewItems(QQuickItem* item, cons
     QQuickItem* scrollView = m_scrollViewByListViewItem[item];
     ScrollViewModelPtr model = m_modelByScrollView[scrollView];
 
-    foreach (int idxToRemote, removeAtIndices) {
-        QQuickItem* itemToRemove = model->takeAt(idxToRemote).value<QQuickItem*>();
+    removedChildren = model->take(removeAtIndices);
+    for (QQuickItem* itemToRemove : removedChildren) {
         itemToRemove->setParentItem(nullptr);
-        removedChildren.push_back(itemToRemove);
     }
 
-    utilities::removeFlexboxChilds(item, removeAtIndices);
+    if (removeFlexboxChilds) {
+        utilities::removeFlexboxChilds(item, removeAtIndices);
+    }
 
     return removedChildren;
 }
@@ -125,12 +170,19 @@ QQuickItem* ScrollViewManager::scrollViewContentItem(QQuickItem* item, int posit
 void ScrollViewManager::addChildItem(QQuickItem* scrollView, QQuickItem* child, int position) const {
     if (arrayScrollingOptimizationEnabled(scrollView)) {
         if (!m_modelByScrollView.contains(scrollView)) {
-            m_modelByScrollView[scrollView] = ScrollViewModelPtr(new ScrollViewModel(bridge()->qmlEngine()));
+            ScrollViewModelPtr model(new ScrollViewModel(bridge()->qmlEngine()));
+            m_modelByScrollView[scrollView] = model;
+            QQmlProperty::write(scrollView, "model", QVariant::fromValue(model.data()));
         }
 
         ScrollViewModelPtr model = m_modelByScrollView[scrollView];
-        foreach (QQuickItem* item, child->childItems()) { model->insert(item, model->count()); }
-        QQmlProperty::write(scrollView, "model", QVariant::fromValue(model.data()));
+        const QList<QQuickItem*> items = child->childItems();
+        QList<int> positions;
+        positions.reserve(items.size());
+        for (int i = 0; i < items.size(); ++i) {
+            positions.append(model->count() + i);
+        }
+        model->insert(items, positions);
         m_scrollViewByListViewItem.insert(child, scrollView);
     } else {
         // Flickable items should be children of contentItem
@@ -140,6 +192,20 @@ void ScrollViewManager::addChildItem(QQuickItem* scrollView, QQuickItem* child,
     }
 }
 
+void ScrollViewManager::addChildItems(QQuickItem* scrollView,
+                                      const QList<QQuickItem*>& children,
+                                      const QList<int>& positions) const {
+    if (arrayScrollingOptimizationEnabled(scrollView)) {
+        for (int i = 0; i < children.size(); ++i) {
+            addChildItem(scrollView, children.at(i), positions.at(i));
+        }
+    } else {
+        QQuickItem* contentItem = QQmlProperty(scrollView, "contentItem").read().value<QQuickItem*>();
+        Q_ASSERT(contentItem != nullptr);
+        utilities::insertChildItemsAt(children, positions, contentItem);
+    }
+}
+
 void ScrollViewManager::scrollBeginDrag() {
     QQuickItem* item = qobject_cast<QQuickItem*>(sender());
     Q_ASSERT(item != nullptr);
@@ -149,6 +215,7 @@ void ScrollViewManager::scrollBeginDrag() {
 void ScrollViewManager::scrollEndDrag() {
     QQuickItem* item = qobject_cast<QQuickItem*>(sender());
     Q_ASSERT(item != nullptr);
+    flushScrollEvent(item);
     notifyJsAboutEvent(tag(item), "scrollEndDrag", buildEventData(item));
 }
 
@@ -156,41 +223,102 @@ void ScrollViewManager::scroll() {
     QQuickItem* item = qobject_cast<QQuickItem*>(sender());
     Q_ASSERT(item != nullptr);
 
-    QTimer* timer = nullptr;
-    if (!m_scrollTimers.contains(item)) {
-        timer = new QTimer(this);
-        m_scrollTimers.insert(item, timer);
+    // Animated values mapped to onScroll follow every move of the content, neither throttled nor held back
+    // by the bridge. A natively driven handler isn't passed to the view, so p_onScroll may not be set.
+    NativeAnimatedModule* nativeAnimatedModule = bridge()->nativeAnimatedModule();
+    if (nativeAnimatedModule && nativeAnimatedModule->hasEventMapping(tag(item), SCROLL_EVENT_NAME)) {
+        nativeAnimatedModule->handleEvent(tag(item), SCROLL_EVENT_NAME, buildEventData(item));
+    }
 
-        connect(timer, &QTimer::timeout, this, [=]() {
-            bool scrollFlagSet = item->property("p_onScroll").toBool();
-            if (scrollFlagSet) {
-                notifyJsAboutEvent(tag(item), "onScroll", buildEventData(item));
-            }
-        });
+    bool scrollFlagSet = PropertyCache::read(item, "p_onScroll").toBool();
+    if (!scrollFlagSet)
+        return;
 
-        connect(item, &QQuickItem::destroyed, this, [=] {
-            m_scrollTimers[item]->stop();
-            m_scrollTimers[item]->deleteLater();
-            m_scrollTimers.remove(item);
-        });
+    m_pendingScrollEvents.insert(item, item);
+    connect(item, &QObject::destroyed, this, &ScrollViewManager::removeScrollView, Qt::UniqueConnection);
 
-    } else {
-        timer = m_scrollTimers[item];
+    QQuickWindow* window = item->window();
+    if (!window) {
+        sendScrollEvents();
+        return;
     }
+    // Content moves many times per frame while flicking, js only needs the position it is rendered at
+    connect(window, &QQuickWindow::afterAnimating, this, &ScrollViewManager::sendScrollEvents, Qt::UniqueConnection);
+    window->update();
+}
 
-    bool isMoving = item->property("moving").toBool();
-    if (isMoving) {
-        timer->start(300);
+void ScrollViewManager::sendScrollEvents() {
+    if (m_pendingScrollEvents.isEmpty())
+        return;
+
+    QQuickWindow* window = qobject_cast<QQuickWindow*>(sender());
+    // Positions of deferred events are read again when they are sent, so stale ones are dropped
+    const bool bridgeBackedUp = bridge()->jsCallsInFlight() > MAX_JS_CALLS_IN_FLIGHT;
+    const qint64 now = m_scrollEventClock.elapsed();
+    // Deferred events are retried when the bridge returns a call or the throttle interval passes,
+    // rather than on every frame
+    if (bridgeBackedUp) {
+        connect(bridge(), &Bridge::jsCallReturned, this, &ScrollViewManager::sendScrollEvents, Qt::UniqueConnection);
     } else {
-        timer->stop();
+        disconnect(bridge(), &Bridge::jsCallReturned, this, &ScrollViewManager::sendScrollEvents);
     }
+    qint64 nextEventDelay = -1;
+
+    for (auto it = m_pendingScrollEvents.begin(); it != m_pendingScrollEvents.end();) {
+        QQuickItem* item = it.value();
+        if (!item) {
+            it = m_pendingScrollEvents.erase(it);
+            continue;
+        }
+        if (window && item->window() != window) {
+            ++it;
+            continue;
+        }
+
+        // scrollEventThrottle is the least interval between events in msecs
+        const int throttle = PropertyCache::read(item, "p_scrollEventThrottle").toInt();
+        auto lastEvent = m_lastScrollEventTimes.constFind(item);
+        if (bridgeBackedUp) {
+            ++it;
+            continue;
+        }
+        if (lastEvent != m_lastScrollEventTimes.constEnd() && now - lastEvent.value() < throttle) {
+            const qint64 delay = throttle - (now - lastEvent.value());
+            nextEventDelay = nextEventDelay < 0 ? delay : qMin(nextEventDelay, delay);
+            ++it;
+            continue;
+        }
+
+        m_lastScrollEventTimes.insert(item, now);
+        sendEventToJs(tag(item), SCROLL_EVENT_NAME, buildEventData(item));
+        it = m_pendingScrollEvents.erase(it);
+    }
+
+    if (nextEventDelay >= 0 &&
+        (!m_scrollThrottleTimer->isActive() || m_scrollThrottleTimer->remainingTime() > nextEventDelay)) {
+        m_scrollThrottleTimer->start(static_cast<int>(nextEventDelay));
+    }
+}
+
+void ScrollViewManager::flushScrollEvent(QQuickItem* item) {
+    // Js must get the last position before an end event, even while the bridge is backed up
+    if (!m_pendingScrollEvents.remove(item))
+        return;
+    m_lastScrollEventTimes.insert(item, m_scrollEventClock.elapsed());
+    sendEventToJs(tag(item), SCROLL_EVENT_NAME, buildEventData(item));
+}
+
+void ScrollViewManager::removeScrollView(QObject* scrollView) {
+    QQuickItem* item = static_cast<QQuickItem*>(scrollView);
+    m_pendingScrollEvents.remove(item);
+    m_lastScrollEventTimes.remove(item);
 }
 
 void ScrollViewManager::onDraggingChanged() {
     QQuickItem* item = qobject_cast<QQuickItem*>(sender());
     Q_ASSERT(item != nullptr);
 
-    bool isDragging = item->property("dragging").toBool();
+    bool isDragging = PropertyCache::read(item, "dragging").toBool();
     if (isDragging) {
         scrollBeginDrag();
     } else {
@@ -204,6 +332,7 @@ void ScrollViewManager::momentumScrollBegin(QQuickItem* item) {
 
 void ScrollViewManager::momentumScrollEnd(QQuickItem* item) {
     // qDebug() << __PRETTY_FUNCTION__;
+    flushScrollEvent(item);
     notifyJsAboutEvent(tag(item), "momentumScrollEnd", buildEventData(item));
 }
 
@@ -218,10 +347,49 @@ void ScrollViewManager::applyTransformation(QQuickItem* item, QVariantList trans
         }
     }
 
-    QQmlListReference r(item, "transform");
-    if (r.canAppend()) {
-        r.clear();
-        r.append(new MatrixTransform(transformVector, item));
+    setItemTransform(item, transformVector);
+}
+
+void ScrollViewManager::updateVisibleRange(QQuickItem* item) {
+    if (!m_modelByScrollView.contains(item))
+        return;
+
+    ScrollViewModelPtr model = m_modelByScrollView[item];
+    model->setWindowed(PropertyCache::read(item, "p_windowed").toBool());
+
+    int first = -1;
+    int last = -1;
+    const int count = model->count();
+    if (count > 0) {
+        const qreal contentX = PropertyCache::read(item, "contentX").toReal();
+        const qreal contentY = PropertyCache::read(item, "contentY").toReal();
+        QMetaObject::invokeMethod(
+            item, "indexAt", Q_RETURN_ARG(int, first), Q_ARG(qreal, contentX), Q_ARG(qreal, contentY));
+        QMetaObject::invokeMethod(item,
+                                  "indexAt",
+                                  Q_RETURN_ARG(int, last),
+                                  Q_ARG(qreal, contentX + item->width() - 1),
+                                  Q_ARG(qreal, contentY + item->height() - 1));
+        // No row at an edge when it shows the header, the footer or spacing past the last row
+        first = first < 0 ? 0 : first;
+        last = last < 0 ? count - 1 : last;
+        if (first > last) {
+            // Inverted lists
+            std::swap(first, last);
+        }
+    }
+
+    if (!model->setVisibleRange(first, last, PropertyCache::read(item, "p_overscanRowCount").toInt()))
+        return;
+
+    if (PropertyCache::read(item, "p_onVisibleRangeChange").toBool()) {
+        notifyJsAboutEvent(tag(item),
+                           "onVisibleRangeChange",
+                           QVariantMap{{"first", first},
+                                       {"last", last},
+                                       {"windowFirst", model->windowFirst()},
+                                       {"windowLast", model->windowLast()},
+                                       {"count", count}});
     }
 }
 
@@ -232,7 +400,7 @@ bool ScrollViewManager::eventFilter(QObject* scrollView, QEvent* event) {
     if (event->type() == QEvent::Wheel) {
 
         QWheelEvent* e = static_cast<QWheelEvent*>(event);
-        bool shouldInvertWheelEvents = scrollView->property("invertedScroll").toBool();
+        bool shouldInvertWheelEvents = PropertyCache::read(scrollView, "invertedScroll").toBool();
 
         if (shouldInvertWheelEvents && !artificialEvents.contains(e)) {
             QWheelEvent* modifiedEvent = new QWheelEvent(e->posF(),
@@ -257,29 +425,28 @@ bool ScrollViewManager::eventFilter(QObject* scrollView, QEvent* event) {
     return false;
 }
 
-namespace {
-template <typename TP> TP propertyValue(QQuickItem* item, const QString& property) {
-    return QQmlProperty(item, property).read().value<TP>();
-}
-} // namespace
-
 QVariantMap ScrollViewManager::buildEventData(QQuickItem* item) const {
+    const double contentX = PropertyCache::read(item, "contentX").toDouble();
+    const double contentY = PropertyCache::read(item, "contentY").toDouble();
+    const double originX = PropertyCache::read(item, "originX").toDouble();
+    const double originY = PropertyCache::read(item, "originY").toDouble();
+
     QVariantMap ed;
     ed.insert("contentOffset",
               QVariantMap{
-                  {"x", propertyValue<double>(item, "contentX") - propertyValue<double>(item, "originX")},
-                  {"y", propertyValue<double>(item, "contentY") - propertyValue<double>(item, "originY")},
+                  {"x", contentX - originX},
+                  {"y", contentY - originY},
               });
     // ed.insert("contentInset", QVariantMap{
     // });
     ed.insert("contentSize",
               QVariantMap{
-                  {"width", propertyValue<double>(item, "contentWidth")},
-                  {"height", propertyValue<double>(item, "contentHeight")},
+                  {"width", PropertyCache::read(item, "contentWidth").toDouble()},
+                  {"height", PropertyCache::read(item, "contentHeight").toDouble()},
               });
     ed.insert("layoutMeasurement",
               QVariantMap{
-                  {"width", propertyValue<double>(item, "width")}, {"height", propertyValue<double>(item, "height")},
+                  {"width", item->width()}, {"height", item->height()},
 
               });
     ed.insert("zoomScale", 1);
@@ -291,8 +458,9 @@ void ScrollViewManager::configureView(QQuickItem* view) const {
     view->setProperty("scrollViewManager", QVariant::fromValue((QObject*)this));
     // This would be prettier with a Functor version, but connect doesnt support it
     view->installEventFilter((QObject*)this);
-    connect(view, SIGNAL(draggingChanged()), SLOT(onDraggingChanged()));
-    connect(view, SIGNAL(movingChanged()), SLOT(scroll()));
+    connect(view, SIGNAL(draggingChanged()), SLOT(onDraggingChanged()), Qt::UniqueConnection);
+    connect(view, SIGNAL(contentXChanged()), SLOT(scroll()), Qt::UniqueConnection);
+    connect(view, SIGNAL(contentYChanged()), SLOT(scroll()), Qt::UniqueConnection);
 }
 
 QString ScrollViewManager::qmlComponentFile(const QVariantMap& properties) const {
@@ -302,7 +470,7 @@ QString ScrollViewManager::qmlComponentFile(const QVariantMap& properties) const
 }
 
 bool ScrollViewManager::arrayScrollingOptimizationEnabled(QQuickItem* item) const {
-    return QQmlProperty(item, "p_enableArrayScrollingOptimization").read().toBool();
+    return PropertyCache::read(item, "p_enableArrayScrollingOptimization").toBool();
 }
 
 #include "scrollviewmanager.moc"
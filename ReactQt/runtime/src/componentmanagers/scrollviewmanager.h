@@ -14,8 +14,15 @@
 #ifndef SCROLLVIEWMANAGER_H
 #define SCROLLVIEWMANAGER_H
 
+#include "scrollbindings.h"
 #include "scrollviewmodel.h"
 #include "viewmanager.h"
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QPointer>
+#include <QTimer>
+
 // #define QT_STATICPLUGIN
 
 class ScrollViewManager : public ViewManager {
@@ -25,6 +32,10 @@ class ScrollViewManager : public ViewManager {
 
     Q_INVOKABLE void scrollTo(int reactTag, double offsetX, double offsetY, bool animated);
     Q_INVOKABLE void scrollToEnd(int reactTag, bool animated);
+    // Drives a property of the view viewTag by the content offset of this scroll view without a js
+    // round trip per frame, see ScrollBindings::bind()
+    Q_INVOKABLE void bindScrollProperty(int reactTag, int viewTag, const QString& property, const QVariantMap& config);
+    Q_INVOKABLE void unbindScrollProperty(int reactTag, int viewTag, const QString& property);
 
 public:
     ScrollViewManager(QObject* parent = 0);
@@ -36,16 +47,24 @@ public:
     QStringList customDirectEventTypes() override;
 
     void addChildItem(QQuickItem* scrollView, QQuickItem* child, int position) const override;
+    void addChildItems(QQuickItem* scrollView,
+                       const QList<QQuickItem*>& children,
+                       const QList<int>& positions) const override;
 
     static bool isArrayScrollingOptimizationEnabled(QQuickItem* item);
-    static void updateListViewItem(QQuickItem* item, QQuickItem* child, int position);
-    static QList<QQuickItem*> removeListViewItems(QQuickItem* item, const QList<int>& removeAtIndices);
+    // Positions are ascending indices of the children after the insertion
+    static void insertListViewItems(QQuickItem* item, const QList<QQuickItem*>& children, const QList<int>& positions);
+    static QList<QQuickItem*> removeListViewItems(QQuickItem* item,
+                                                  const QList<int>& removeAtIndices,
+                                                  bool removeFlexboxChilds = true);
     static QQuickItem* scrollViewContentItem(QQuickItem* item, int position);
 
 public Q_SLOTS:
     void momentumScrollBegin(QQuickItem* item);
     void momentumScrollEnd(QQuickItem* item);
     void applyTransformation(QQuickItem* item, QVariantList transform);
+    // Called by list views when scrolled, resized or their rows change
+    void updateVisibleRange(QQuickItem* item);
 
 protected:
     bool eventFilter(QObject* scrollView, QEvent* e) override;
@@ -54,17 +73,28 @@ private Q_SLOTS:
     void scrollBeginDrag();
     void scrollEndDrag();
     void scroll();
+    void sendScrollEvents();
+    void removeScrollView(QObject* scrollView);
     void onDraggingChanged();
 
 private:
     QVariantMap buildEventData(QQuickItem* item) const;
+    // Sends the onScroll event still deferred for the item, if any
+    void flushScrollEvent(QQuickItem* item);
     virtual void configureView(QQuickItem* view) const override;
     virtual QString qmlComponentFile(const QVariantMap& properties) const override;
     bool arrayScrollingOptimizationEnabled(QQuickItem* item) const;
 
     static QMap<QQuickItem*, QQuickItem*> m_scrollViewByListViewItem;
     static QMap<QQuickItem*, ScrollViewModelPtr> m_modelByScrollView;
-    static QMap<QQuickItem*, QTimer*> m_scrollTimers;
+
+    // Scroll views moved since their last onScroll event, sent once per frame with the latest position
+    QHash<QQuickItem*, QPointer<QQuickItem>> m_pendingScrollEvents;
+    QHash<QQuickItem*, qint64> m_lastScrollEventTimes;
+    QElapsedTimer m_scrollEventClock;
+    // Sends the events deferred by scrollEventThrottle once their interval has passed
+    QTimer* m_scrollThrottleTimer = nullptr;
+    ScrollBindings* m_scrollBindings = nullptr;
 };
 
 #endif // SCROLLVIEWMANAGER_H
@@ -1,5 +1,18 @@
 #include "scrollviewmodel.h"
+#include "layout/flexbox.h"
 #include <QDebug>
+#include <QHash>
+
+#include <algorithm>
+
+namespace {
+void setFrozen(QQuickItem* item, bool frozen) {
+    Flexbox* flexbox = Flexbox::findFlexbox(item);
+    if (flexbox) {
+        flexbox->setFrozen(frozen);
+    }
+}
+} // namespace
 
 ScrollViewModel::ScrollViewModel(QQmlEngine* engine, QObject* parent) : QAbstractListModel(parent) {
     m_engine = engine;
@@ -22,14 +35,148 @@ QVariant ScrollViewModel::data(const QModelIndex& index, int role) const {
 }
 
 void ScrollViewModel::insert(QQuickItem* item, int position) {
-    beginInsertRows(QModelIndex(), position, position);
-    m_model.insert(position, QVariant::fromValue(item));
-    endInsertRows();
+    insert(QList<QQuickItem*>{item}, QList<int>{position});
 }
 
 QVariant ScrollViewModel::takeAt(int position) {
-    beginRemoveRows(QModelIndex(), position, position);
-    QVariant result = m_model.takeAt(position);
-    endRemoveRows();
-    return result;
+    return QVariant::fromValue(take(QList<int>{position}).first());
+}
+
+void ScrollViewModel::insert(const QList<QQuickItem*>& items, const QList<int>& positions) {
+    Q_ASSERT(items.size() == positions.size());
+
+    if (m_windowed) {
+        // Before the rows are announced, so a window update they trigger can thaw the visible ones.
+        // Rows are frozen once Flexbox::updateChildren() attaches them, or after their first layout.
+        for (QQuickItem* item : items) {
+            setFrozen(item, true);
+        }
+    }
+
+    int runStart = 0;
+    while (runStart < positions.size()) {
+        int runEnd = runStart;
+        while (runEnd + 1 < positions.size() && positions.at(runEnd + 1) == positions.at(runEnd) + 1) {
+            ++runEnd;
+        }
+
+        beginInsertRows(QModelIndex(), positions.at(runStart), positions.at(runEnd));
+        for (int i = runStart; i <= runEnd; ++i) {
+            m_model.insert(positions.at(i), QVariant::fromValue(items.at(i)));
+        }
+        endInsertRows();
+        runStart = runEnd + 1;
+    }
+
+}
+
+QList<QQuickItem*> ScrollViewModel::take(const QList<int>& indices) {
+    QList<int> sortedIndices = indices;
+    std::sort(sortedIndices.begin(), sortedIndices.end());
+
+    // Runs are removed from the back, so indices of the runs before them stay valid
+    QHash<int, QQuickItem*> takenByIndex;
+    int runEnd = sortedIndices.size() - 1;
+    while (runEnd >= 0) {
+        int runStart = runEnd;
+        while (runStart > 0 && sortedIndices.at(runStart - 1) == sortedIndices.at(runStart) - 1) {
+            --runStart;
+        }
+
+        const int first = sortedIndices.at(runStart);
+        const int last = sortedIndices.at(runEnd);
+        beginRemoveRows(QModelIndex(), first, last);
+        for (int i = first; i <= last; ++i) {
+            takenByIndex.insert(i, itemAt(i));
+        }
+        m_model.erase(m_model.begin() + first, m_model.begin() + last + 1);
+        endRemoveRows();
+        runEnd = runStart - 1;
+    }
+
+    QList<QQuickItem*> taken;
+    taken.reserve(indices.size());
+    for (int index : indices) {
+        QQuickItem* item = takenByIndex.value(index);
+        taken.append(item);
+        if (m_windowed) {
+            // Removed rows are either destroyed or inserted again elsewhere
+            m_windowItems.remove(item);
+            setFrozen(item, false);
+        }
+    }
+    return taken;
+}
+
+bool ScrollViewModel::windowed() const {
+    return m_windowed;
+}
+
+void ScrollViewModel::setWindowed(bool windowed) {
+    if (windowed == m_windowed)
+        return;
+
+    m_windowed = windowed;
+    m_windowItems.clear();
+    for (const QVariant& item : m_model) {
+        setFrozen(item.value<QQuickItem*>(), windowed);
+    }
+    updateWindow();
+}
+
+bool ScrollViewModel::setVisibleRange(int first, int last, int overscanCount) {
+    const bool changed = first != m_visibleFirst || last != m_visibleLast;
+    m_visibleFirst = first;
+    m_visibleLast = last;
+    m_overscanCount = qMax(0, overscanCount);
+
+    // Rows may have been inserted or removed inside an unchanged range
+    updateWindow();
+    return changed;
+}
+
+int ScrollViewModel::visibleFirst() const {
+    return m_visibleFirst;
+}
+
+int ScrollViewModel::visibleLast() const {
+    return m_visibleLast;
+}
+
+int ScrollViewModel::windowFirst() const {
+    return m_visibleFirst < 0 ? -1 : qMax(0, m_visibleFirst - m_overscanCount);
+}
+
+int ScrollViewModel::windowLast() const {
+    return m_visibleLast < 0 ? -1 : qMin(count() - 1, m_visibleLast + m_overscanCount);
+}
+
+QQuickItem* ScrollViewModel::itemAt(int position) const {
+    return m_model.at(position).value<QQuickItem*>();
+}
+
+void ScrollViewModel::updateWindow() {
+    if (!m_windowed)
+        return;
+
+    QSet<QQuickItem*> windowItems;
+    const int first = windowFirst();
+    const int last = windowLast();
+    if (first >= 0) {
+        for (int i = first; i <= last; ++i) {
+            windowItems.insert(itemAt(i));
+        }
+    }
+
+    for (QQuickItem* item : m_windowItems) {
+        if (!windowItems.contains(item)) {
+            setFrozen(item, true);
+        }
+    }
+    for (QQuickItem* item : windowItems) {
+        if (!m_windowItems.contains(item)) {
+            setFrozen(item, false);
+        }
+    }
+    m_windowItems.swap(windowItems);
 }
@@ -3,6 +3,7 @@
 
 #include <QAbstractListModel>
 #include <QQuickItem>
+#include <QSet>
 #include <QSharedPointer>
 
 class ScrollViewModel : public QAbstractListModel {
@@ -18,10 +19,35 @@ public:
     QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const;
     void insert(QQuickItem* item, int position);
     QVariant takeAt(int position);
+    // Positions are ascending indices of the items after the insertion. Consecutive positions
+    // are inserted as one range, so a view relayouts once per batch rather than once per row.
+    void insert(const QList<QQuickItem*>& items, const QList<int>& positions);
+    // Indices are of the rows before the removal, in any order. Returns the items in the same order.
+    QList<QQuickItem*> take(const QList<int>& indices);
+
+    // In windowed mode only the rows of the visible range and overscanCount rows around it are laid out,
+    // Yoga nodes of the others are frozen until the window reaches them again
+    bool windowed() const;
+    void setWindowed(bool windowed);
+    // Returns false if the visible range is the one set before
+    bool setVisibleRange(int first, int last, int overscanCount);
+    int visibleFirst() const;
+    int visibleLast() const;
+    int windowFirst() const;
+    int windowLast() const;
 
 private:
+    QQuickItem* itemAt(int position) const;
+    void updateWindow();
+
     QVariantList m_model;
     QQmlEngine* m_engine = nullptr;
+
+    bool m_windowed = false;
+    int m_visibleFirst = -1;
+    int m_visibleLast = -1;
+    int m_overscanCount = 0;
+    QSet<QQuickItem*> m_windowItems;
 };
 
 using ScrollViewModelPtr = QSharedPointer<ScrollViewModel>;
@@ -20,6 +20,7 @@
 
 #include "attachedproperties.h"
 #include "bridge.h"
+#include "propertycache.h"
 #include "propertyhandler.h"
 #include "textinputmanager.h"
 #include "utilities.h"
@@ -61,15 +62,15 @@ QStringList TextInputManager::customDirectEventTypes() {
 }
 
 void TextInputManager::sendTextEditedToJs(QQuickItem* textInput) {
-    QString text = textInput->property("text").toString();
+    QString text = PropertyCache::read(textInput, "text").toString();
     sendTextInputEvent(textInput, EVENT_ON_TEXT_CHANGE, QVariantMap{{"text", text}});
 }
 
 void TextInputManager::sendSelectionChangeToJs(QQuickItem* textInput) {
     if (!textInput)
         return;
-    int start = textInput->property("selectionStart").toInt();
-    int end = textInput->property("selectionEnd").toInt();
+    int start = PropertyCache::read(textInput, "selectionStart").toInt();
+    int end = PropertyCache::read(textInput, "selectionEnd").toInt();
 
     // TODO: Generation of onSelectionChange event causes issue
     // https://github.com/status-im/react-native-desktop/issues/210
@@ -119,7 +120,7 @@ void TextInputManager::sendTextInputEvent(QQuickItem* textInput, QString eventNa
     if (!textInput)
         return;
 
-    QString text = textInput->property("text").toString();
+    QString text = PropertyCache::read(textInput, "text").toString();
     int parentTag = tag(textInput->parentItem());
 
     QVariantMap eventData = QVariantMap{{"target", parentTag}};
@@ -11,9 +11,11 @@
  *
  */
 
+#include <QMetaProperty>
 #include <QQmlComponent>
 #include <QQmlProperty>
 #include <QQuickItem>
+#include <QQuickTextDocument>
 #include <QString>
 #include <QVariant>
 
@@ -22,10 +24,26 @@
 #include "attachedproperties.h"
 #include "bridge.h"
 #include "layout/flexbox.h"
+#include "layout/textmeasurer.h"
+#include "propertycache.h"
 #include "propertyhandler.h"
+#include "rootview.h"
 #include "textmanager.h"
 #include "utilities.h"
-#include <cmath>
+
+namespace {
+// Style props a nested text takes from its text parent unless it sets them itself
+const QSet<QString>& inheritedProps() {
+    static const QSet<QString> props{"fontFamily",
+                                     "fontSize",
+                                     "color",
+                                     "backgroundColor",
+                                     "fontStyle",
+                                     "fontWeight",
+                                     "textDecorationLine"};
+    return props;
+}
+} // namespace
 
 TextManager::TextManager(QObject* parent) : RawTextManager(parent) {}
 
@@ -40,9 +58,21 @@ PropertyHandler* TextManager::propertyHandler(QObject* object) {
 
     // we keep track of all assigned properties because if property not assigned explicitly,
     // it should be taken from parent
-    return new PropertyHandler(object, [&](QObject* object, const QString& propertyName, const QVariant&) {
-        m_explicitlySetProps[object].insert(propertyName);
-    });
+    QQuickItem* textItem = static_cast<QQuickItem*>(object);
+    return new PropertyHandler(
+        object, [this, textItem](QObject* object, const QString& propertyName, const QVariant& value) {
+            if (object != textItem || !inheritedProps().contains(propertyName))
+                return;
+
+            TextNode& node = textNode(textItem);
+            // Resetting a prop to null makes the item inherit it again
+            if (value.isNull()) {
+                node.explicitProps.remove(propertyName);
+            } else {
+                node.explicitProps.insert(propertyName);
+            }
+            invalidateStyle(textItem);
+        });
 }
 
 QString TextManager::moduleName() {
@@ -64,72 +94,226 @@ void TextManager::configureView(QQuickItem* view) const {
 
 void TextManager::updateMeasureFunction(QQuickItem* textItem) {
 
+    bool childIsTopReactTextInTextHierarchy = PropertyCache::read(textItem, "textIsTopInBlock").toBool();
+
+    if (!childIsTopReactTextInTextHierarchy && m_textBlocks.contains(textItem)) {
+        // Text of a nested item is shown by the top item of its block
+        m_textBlocks.remove(textItem);
+        AttributedText().applyTo(textDocument(textItem));
+    }
+
     Flexbox* flexbox = Flexbox::findFlexbox(textItem);
     if (!flexbox) {
         return;
     }
 
-    bool childIsTopReactTextInTextHierarchy = textItem->property("textIsTopInBlock").toBool();
-
     if (childIsTopReactTextInTextHierarchy) {
-        flexbox->setMeasureFunction([=](
-            YGNodeRef /*node*/, float width, YGMeasureMode /*widthMode*/, float height, YGMeasureMode /*heightMode*/) {
-            resizeToWidth(textItem, width);
-            resizeToHeight(textItem, height);
-            float h = textItem->height();
-            float w = textItem->width();
-            return YGSize{w, h};
-        });
+        setMeasureFunction(textItem, textBlock(textItem).measuredText);
     } else {
         flexbox->setMeasureFunction(nullptr);
     }
 }
 
-QString TextManager::escape(const QString& text) {
-    return text.toHtmlEscaped();
+void TextManager::markTextDirty(QQuickItem* textItem) {
+    m_dirtyTexts.insert(textItem, textItem);
+
+    RootView* rootView = bridge() ? bridge()->visualParent() : nullptr;
+    if (!rootView) {
+        updateDirtyTexts();
+        return;
+    }
+    connect(rootView, &RootView::aboutToLayout, this, &TextManager::updateDirtyTexts, Qt::UniqueConnection);
 }
 
-void TextManager::resizeToWidth(QQuickItem* textItem, double width) {
-    textItem->setWidth(width);
-    double contentWidth = textItem->property("contentWidth").value<double>();
-    double sw = 0;
-    if (std::isnan(width)) {
-        sw = contentWidth;
-    } else {
-        sw = contentWidth == 0 ? width : qMin(contentWidth, width);
+void TextManager::updateDirtyTexts() {
+    if (m_dirtyTexts.isEmpty())
+        return;
+
+    QSet<QQuickItem*> topItems;
+    for (const QPointer<QQuickItem>& textItem : m_dirtyTexts) {
+        if (!textItem)
+            continue;
+
+        // Moved texts inherit from their new parent
+        TextNode& node = textNode(textItem);
+        QQuickItem* parent = parentTextItem(textItem);
+        if (node.parent != parent) {
+            node.parent = parent;
+            invalidateStyle(textItem);
+        }
+
+        QQuickItem* topItem = textItem;
+        while (QQuickItem* parent = parentTextItem(topItem)) {
+            topItem = parent;
+        }
+        topItems.insert(topItem);
+    }
+    m_dirtyTexts.clear();
+
+    for (QQuickItem* topItem : topItems) {
+        updateText(topItem);
     }
-    textItem->setWidth(sw);
 }
 
-void TextManager::resizeToHeight(QQuickItem* textItem, double height) {
-    textItem->setHeight(height);
-    double contentHeight = textItem->property("contentHeight").value<double>();
-    double sh = 0;
-    if (std::isnan(height)) {
-        sh = contentHeight;
-    } else {
-        sh = contentHeight == 0 ? height : qMin(contentHeight, height);
+void TextManager::updateText(QQuickItem* topItem) {
+    TextBlock& block = textBlock(topItem);
+    AttributedText text = attributedText(topItem);
+    if (text == block.text)
+        return;
+
+    block.text = text;
+    text.applyTo(textDocument(topItem));
+    storeMeasuredText(topItem, block);
+
+    Flexbox* flexbox = Flexbox::findFlexbox(topItem);
+    if (flexbox) {
+        flexbox->markDirty();
     }
-    textItem->setHeight(sh);
 }
 
-QVariant TextManager::nestedPropertyValue(QQuickItem* item, const QString& propertyName) {
-    // return value if it is explicitly set on current item
-    if (propertyExplicitlySet(item, propertyName)) {
-        return item->property(propertyName.toStdString().c_str());
+void TextManager::updateMeasuredFont() {
+    QQuickItem* textItem = qobject_cast<QQuickItem*>(sender());
+    if (m_textBlocks.contains(textItem)) {
+        storeMeasuredText(textItem, m_textBlocks[textItem]);
     }
+}
+
+TextManager::TextBlock& TextManager::textBlock(QQuickItem* textItem) {
+    auto it = m_textBlocks.find(textItem);
+    if (it != m_textBlocks.end())
+        return it.value();
+
+    TextBlock block;
+    std::shared_ptr<MeasuredText> measuredText = std::make_shared<MeasuredText>();
+    measuredText->font = PropertyCache::read(textItem, "font").value<QFont>();
+    block.measuredText = measuredText;
+
+    const QMetaObject* itemMetaObject = textItem->metaObject();
+    QMetaProperty fontProperty = itemMetaObject->property(itemMetaObject->indexOfProperty("font"));
+    const QMetaMethod updateSlot = metaObject()->method(metaObject()->indexOfSlot("updateMeasuredFont()"));
+    connect(textItem, fontProperty.notifySignal(), this, updateSlot, Qt::UniqueConnection);
+    connect(textItem, &QObject::destroyed, this, &TextManager::removeTextItem, Qt::UniqueConnection);
+
+    return m_textBlocks.insert(textItem, block).value();
+}
 
-    // check if any of text parents has this property explicitly set
-    QQuickItem* parent = parentTextItem(item);
-    while (parent) {
-        if (propertyExplicitlySet(parent, propertyName)) {
-            return parent->property(propertyName.toStdString().c_str());
+TextManager::TextNode& TextManager::textNode(QQuickItem* textItem) {
+    auto it = m_textNodes.find(textItem);
+    if (it != m_textNodes.end())
+        return it.value();
+
+    connect(textItem, &QObject::destroyed, this, &TextManager::removeTextItem, Qt::UniqueConnection);
+
+    TextNode node;
+    node.parent = parentTextItem(textItem);
+    return m_textNodes.insert(textItem, node).value();
+}
+
+void TextManager::removeTextItem(QObject* textItem) {
+    QQuickItem* item = static_cast<QQuickItem*>(textItem);
+    m_textBlocks.remove(item);
+    m_textNodes.remove(item);
+    m_dirtyTexts.remove(item);
+}
+
+void TextManager::storeMeasuredText(QQuickItem* textItem, TextBlock& block) {
+    std::shared_ptr<MeasuredText> measuredText = std::make_shared<MeasuredText>();
+    measuredText->text = block.text;
+    measuredText->font = PropertyCache::read(textItem, "font").value<QFont>();
+    block.measuredText = measuredText;
+    setMeasureFunction(textItem, measuredText);
+}
+
+void TextManager::setMeasureFunction(QQuickItem* textItem, const std::shared_ptr<const MeasuredText>& measuredText) {
+    Flexbox* flexbox = Flexbox::findFlexbox(textItem);
+    if (!flexbox)
+        return;
+
+    // Measured offscreen, so Yoga may call it on the layout thread and as often as it likes
+    flexbox->setMeasureFunction(
+        [=](YGNodeRef /*node*/, float width, YGMeasureMode widthMode, float height, YGMeasureMode heightMode) {
+            return TextMeasurer::measure(measuredText->text, measuredText->font, width, widthMode, height, heightMode);
+        },
+        true);
+}
+
+AttributedText TextManager::attributedText(QQuickItem* textItem) {
+    AttributedText text;
+    TextStyle style;
+    bool styleResolved = false;
+
+    const QList<QQuickItem*> children = textItem->childItems();
+    for (int i = 0; i < children.size(); ++i) {
+        QQuickItem* child = children.at(i);
+        const QString typeName = PropertyCache::read(child, "typeName").toString();
+
+        if (typeName == "ReactText") {
+            // Touches on nested texts are routed by the index of the child they hit
+            text.append(attributedText(child), QString::number(i));
+        } else if (typeName == "ReactRawText") {
+            if (!styleResolved) {
+                style = resolvedStyle(textItem);
+                styleResolved = true;
+            }
+            text.append(PropertyCache::read(child, "p_text").toString(), style);
         }
-        parent = parentTextItem(parent);
     }
+    return text;
+}
+
+TextStyle TextManager::resolvedStyle(QQuickItem* textItem) {
+    auto it = m_textNodes.constFind(textItem);
+    if (it != m_textNodes.constEnd() && it->styleResolved)
+        return it->style;
+
+    // Resolved before taking the node, inserting the parent's node may rehash m_textNodes
+    QQuickItem* parent = parentTextItem(textItem);
+    TextStyle style = parent ? resolvedStyle(parent) : TextStyle();
+
+    TextNode& node = textNode(textItem);
+    // Top item of a block has nothing to inherit and uses its own values, set or default
+    auto ownValue = [&](const char* propertyName) -> bool {
+        return !parent || node.explicitProps.contains(QLatin1String(propertyName));
+    };
+    if (ownValue("fontFamily"))
+        style.fontFamily = PropertyCache::read(textItem, "p_fontFamily").toString();
+    if (ownValue("fontSize"))
+        style.fontSize = PropertyCache::read(textItem, "p_fontSize").toDouble();
+    if (ownValue("color"))
+        style.color = PropertyCache::read(textItem, "p_color").value<QColor>();
+    if (ownValue("backgroundColor"))
+        style.backgroundColor = PropertyCache::read(textItem, "p_backgroundColor").value<QColor>();
+    if (ownValue("fontStyle"))
+        style.fontStyle = PropertyCache::read(textItem, "p_fontStyle").toString();
+    if (ownValue("fontWeight"))
+        style.fontWeight = PropertyCache::read(textItem, "p_fontWeight").toString();
+    if (ownValue("textDecorationLine"))
+        style.textDecorationLine = PropertyCache::read(textItem, "p_textDecorationLine").toString();
 
-    // no parents has this property explicitly set, so we use default value
-    return item->property(propertyName.toStdString().c_str());
+    node.parent = parent;
+    node.style = style;
+    node.styleResolved = true;
+    return style;
+}
+
+void TextManager::invalidateStyle(QQuickItem* textItem) {
+    auto it = m_textNodes.find(textItem);
+    if (it == m_textNodes.end() || !it->styleResolved)
+        return;
+
+    // Nested texts that inherit from this one were resolved after it, so a subtree stops at unresolved nodes
+    it->styleResolved = false;
+    for (QQuickItem* child : textItem->childItems()) {
+        if (PropertyCache::read(child, "typeName").toString() == "ReactText") {
+            invalidateStyle(child);
+        }
+    }
+}
+
+QTextDocument* TextManager::textDocument(QQuickItem* textItem) {
+    QObject* document = PropertyCache::read(textItem, "textDocument").value<QObject*>();
+    Q_ASSERT(qobject_cast<QQuickTextDocument*>(document));
+    return static_cast<QQuickTextDocument*>(document)->textDocument();
 }
 
 QQuickItem* TextManager::parentTextItem(QQuickItem* textItem) {
@@ -140,16 +324,9 @@ QQuickItem* TextManager::parentTextItem(QQuickItem* textItem) {
     if (!visualParent)
         return nullptr;
 
-    QVariant typeName = visualParent->property("typeName");
+    QVariant typeName = PropertyCache::read(visualParent, "typeName");
     if (!typeName.isValid())
         return nullptr;
 
     return (typeName.toString() == "ReactText") ? static_cast<QQuickItem*>(visualParent) : nullptr;
 }
-
-bool TextManager::propertyExplicitlySet(QQuickItem* item, const QString& propertyName) {
-    if (m_explicitlySetProps.contains(item)) {
-        return m_explicitlySetProps[item].contains(propertyName);
-    }
-    return false;
-}
@@ -14,8 +14,16 @@
 #ifndef TEXTMANAGER_H
 #define TEXTMANAGER_H
 
+#include "layout/attributedtext.h"
 #include "rawtextmanager.h"
 
+#include <QFont>
+#include <QHash>
+#include <QPointer>
+#include <QSet>
+
+#include <memory>
+
 // #define QT_STATICPLUGIN
 
 class TextManager : public RawTextManager {
@@ -35,26 +43,59 @@ public:
     bool shouldLayout() const override;
 
     typedef std::map<QString, QVariant> PropertyMap;
-    static void resizeToWidth(QQuickItem* textItem, double width);
-    static void resizeToHeight(QQuickItem* textItem, double height);
 
 public slots:
-    QVariant nestedPropertyValue(QQuickItem* item, const QString& propertyName);
     void updateMeasureFunction(QQuickItem* textItem);
-    QString escape(const QString& text);
+    // Marks the block textItem is part of for a rebuild, which happens once before the next layout pass
+    void markTextDirty(QQuickItem* textItem);
+
+private slots:
+    void updateDirtyTexts();
+    void updateMeasuredFont();
+    void removeTextItem(QObject* textItem);
 
 private:
     QQuickItem* parentTextItem(QQuickItem* textItem);
-    bool propertyExplicitlySet(QQuickItem* item, const QString& propertyName);
 
     virtual QString qmlComponentFile(const QVariantMap& properties) const override;
     virtual void configureView(QQuickItem* view) const override;
 
 private:
-    using StringSet = QSet<QString>;
-    using PropertiesMap = QMap<QObject*, StringSet>;
-
-    PropertiesMap m_explicitlySetProps;
+    // Style of a text item with the props it doesn't set itself inherited from its text parent.
+    // Resolved on the first rebuild that needs it and kept until the item or one of its ancestors changes.
+    struct TextNode {
+        QSet<QString> explicitProps;
+        QQuickItem* parent = nullptr;
+        TextStyle style;
+        bool styleResolved = false;
+    };
+    QHash<QQuickItem*, TextNode> m_textNodes;
+
+    // What the measure function of a text block lays out. Copied from the item on the GUI thread,
+    // so measuring on the layout thread doesn't read QML properties. A change makes a new copy,
+    // passes in flight keep measuring the one they started with.
+    struct MeasuredText {
+        AttributedText text;
+        QFont font;
+    };
+    // Top text item of a block of nested texts
+    struct TextBlock {
+        AttributedText text;
+        std::shared_ptr<const MeasuredText> measuredText;
+    };
+    QHash<QQuickItem*, TextBlock> m_textBlocks;
+    // Texts changed since the last rebuild, usually several items of the same block
+    QHash<QQuickItem*, QPointer<QQuickItem>> m_dirtyTexts;
+
+    void updateText(QQuickItem* topItem);
+    TextBlock& textBlock(QQuickItem* textItem);
+    void storeMeasuredText(QQuickItem* textItem, TextBlock& block);
+    void setMeasureFunction(QQuickItem* textItem, const std::shared_ptr<const MeasuredText>& measuredText);
+    AttributedText attributedText(QQuickItem* textItem);
+    TextNode& textNode(QQuickItem* textItem);
+    TextStyle resolvedStyle(QQuickItem* textItem);
+    void invalidateStyle(QQuickItem* textItem);
+    QTextDocument* textDocument(QQuickItem* textItem);
 };
 
 #endif // TEXTMANAGER_H
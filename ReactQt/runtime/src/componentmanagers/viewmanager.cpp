@@ -12,16 +12,20 @@
  */
 
 #include <QMatrix4x4>
+#include <QQmlIncubator>
 #include <QQmlProperty>
 #include <QQuickItem>
 #include <QString>
+#include <QTimer>
 #include <QVariant>
 
 #include "attachedproperties.h"
 #include "bridge.h"
 #include "layout/flexbox.h"
+#include "nativeanimatedmodule.h"
 #include "propertyhandler.h"
 #include "reactitem.h"
+#include "reactview.h"
 #include "rootview.h"
 #include "textmanager.h"
 #include "valuecoercion.h"
@@ -33,11 +37,44 @@ using namespace utilities;
 
 namespace {
 const QString EVENT_ONLAYOUT = "onLayout";
-}
+const char COMPONENT_FILE_PROPERTY[] = "_reactComponentFile";
+const QString VIEW_COMPONENT_FILE = "qrc:/qml/ReactView.qml";
+const int DEFAULT_VIEW_POOL_CAPACITY = 256;
+
+class ViewIncubator : public QQmlIncubator {
+public:
+    ViewIncubator(const std::function<void(ViewIncubator*)>& onFinished)
+        : QQmlIncubator(QQmlIncubator::Asynchronous), m_onFinished(onFinished) {}
 
-ViewManager::ViewManager(QObject* parent) : QObject(parent) {}
+protected:
+    void statusChanged(Status status) override {
+        if (status == QQmlIncubator::Ready || status == QQmlIncubator::Error) {
+            m_onFinished(this);
+        }
+    }
 
-ViewManager::~ViewManager() {}
+private:
+    std::function<void(ViewIncubator*)> m_onFinished;
+};
+} // namespace
+
+ViewManager::ViewManager(QObject* parent) : QObject(parent) {
+    // Only plain views are pooled by default, other components opt in with setRecyclePoolCapacity()
+    m_recyclePoolCapacities.insert(NATIVE_VIEW_COMPONENT, DEFAULT_VIEW_POOL_CAPACITY);
+    m_recyclePoolCapacities.insert(VIEW_COMPONENT_FILE, DEFAULT_VIEW_POOL_CAPACITY);
+}
+
+ViewManager::~ViewManager() {
+    for (QQmlIncubator* incubator : m_incubators) {
+        incubator->clear();
+        delete incubator;
+    }
+    for (const QList<QQuickItem*>& pool : m_recyclePools) {
+        for (QQuickItem* item : pool) {
+            item->deleteLater();
+        }
+    }
+}
 
 void ViewManager::setBridge(Bridge* bridge) {
     m_bridge = bridge;
@@ -81,7 +118,19 @@ void ViewManager::addChildItem(QQuickItem* container, QQuickItem* child, int pos
     utilities::insertChildItemAt(child, position, container);
 }
 
+void ViewManager::addChildItems(QQuickItem* container,
+                                const QList<QQuickItem*>& children,
+                                const QList<int>& positions) const {
+    utilities::insertChildItemsAt(children, positions, container);
+}
+
 QQuickItem* ViewManager::view(const QVariantMap& properties) {
+    QQuickItem* recycledView = takeRecycledView(componentKey(properties));
+    if (recycledView) {
+        configureView(recycledView);
+        return recycledView;
+    }
+
     QQuickItem* newView = createView(properties);
     if (newView) {
         configureView(newView);
@@ -89,15 +138,64 @@ QQuickItem* ViewManager::view(const QVariantMap& properties) {
     return newView;
 }
 
+void ViewManager::incubateView(const QVariantMap& properties, const ViewReadyCallback& callback) {
+    if (createsNativeViews() || hasRecycledView(componentKey(properties))) {
+        // Pooled and native views are cheap to get, nothing to incubate
+        callback(view(properties));
+        return;
+    }
+
+    const QString qmlSrc = qmlComponentFile(properties);
+
+    QmlComponentPtr qmlComponent = component(qmlSrc);
+    ViewIncubator* incubator = new ViewIncubator([=](ViewIncubator* finished) {
+        QQuickItem* item = qobject_cast<QQuickItem*>(finished->object());
+        if (item == nullptr) {
+            qCCritical(VIEWMANAGER) << QString("Can't incubate QML item for component %1").arg(qmlSrc)
+                                    << finished->errors();
+        } else {
+            if (recyclePoolCapacity(qmlSrc) > 0) {
+                item->setProperty(COMPONENT_FILE_PROPERTY, qmlSrc);
+            }
+            configureView(item);
+        }
+
+        // Incubator can't be deleted from inside its own status notification
+        m_incubators.removeOne(finished);
+        QTimer::singleShot(0, this, [finished] { delete finished; });
+
+        callback(item);
+    });
+    m_incubators.push_back(incubator);
+    qmlComponent->create(*incubator);
+}
+
 void ViewManager::configureView(QQuickItem* view) const {
     view->setProperty("viewManager", QVariant::fromValue((QObject*)this));
 }
 
 QString ViewManager::qmlComponentFile(const QVariantMap& properties) const {
-    return "qrc:/qml/ReactView.qml";
+    return VIEW_COMPONENT_FILE;
+}
+
+bool ViewManager::createsNativeViews() const {
+    return metaObject() == &ViewManager::staticMetaObject;
+}
+
+QString ViewManager::componentKey(const QVariantMap& properties) const {
+    return createsNativeViews() ? QString(NATIVE_VIEW_COMPONENT) : qmlComponentFile(properties);
 }
 
 void ViewManager::notifyJsAboutEvent(int senderTag, const QString& eventName, const QVariantMap& eventData) const {
+    const QString normalizedName = normalizeInputEventName(eventName);
+    // Animated values mapped to the event follow it natively, before js gets it
+    if (NativeAnimatedModule* nativeAnimatedModule = bridge()->nativeAnimatedModule()) {
+        nativeAnimatedModule->handleEvent(senderTag, normalizedName, eventData);
+    }
+    sendEventToJs(senderTag, normalizedName, eventData);
+}
+
+void ViewManager::sendEventToJs(int senderTag, const QString& eventName, const QVariantMap& eventData) const {
     bridge()->enqueueJSCall(
         "RCTEventEmitter", "receiveEvent", QVariantList{senderTag, normalizeInputEventName(eventName), eventData});
 }
@@ -112,6 +210,67 @@ int ViewManager::tag(QQuickItem* view) {
     return rap->tag();
 }
 
+int ViewManager::recyclePoolCapacity(const QString& qmlComponentFile) const {
+    return m_recyclePoolCapacities.value(qmlComponentFile, 0);
+}
+
+void ViewManager::setRecyclePoolCapacity(const QString& qmlComponentFile, int capacity) {
+    capacity = qMax(0, capacity);
+    m_recyclePoolCapacities.insert(qmlComponentFile, capacity);
+
+    QList<QQuickItem*>& pool = m_recyclePools[qmlComponentFile];
+    while (pool.size() > capacity) {
+        pool.takeLast()->deleteLater();
+    }
+}
+
+bool ViewManager::canRecycleView(QQuickItem* view) const {
+    Q_ASSERT(view);
+    return recyclePoolCapacity(view->property(COMPONENT_FILE_PROPERTY).toString()) > 0;
+}
+
+bool ViewManager::recycleView(QQuickItem* view) {
+    if (!canRecycleView(view))
+        return false;
+
+    const QString componentFile = view->property(COMPONENT_FILE_PROPERTY).toString();
+    QList<QQuickItem*>& pool = m_recyclePools[componentFile];
+    if (pool.size() >= recyclePoolCapacity(componentFile))
+        return false;
+
+    resetView(view);
+    pool.push_back(view);
+    return true;
+}
+
+void ViewManager::resetView(QQuickItem* view) const {
+    view->setParentItem(nullptr);
+    view->setParent(nullptr);
+
+    AttachedProperties* ap = AttachedProperties::get(view, false);
+    if (ap && ap->propertyHandler()) {
+        ap->propertyHandler()->resetProperties();
+    }
+
+    // Geometry is assigned by the next layout pass, zeroing it makes sure onLayout is sent again
+    view->setPosition(QPointF());
+    view->setSize(QSizeF());
+}
+
+bool ViewManager::hasRecycledView(const QString& qmlComponentFile) const {
+    return !m_recyclePools.value(qmlComponentFile).isEmpty();
+}
+
+QQuickItem* ViewManager::takeRecycledView(const QString& qmlComponentFile) {
+    auto it = m_recyclePools.find(qmlComponentFile);
+    if (it == m_recyclePools.end() || it->isEmpty())
+        return nullptr;
+
+    QQuickItem* item = it->takeLast();
+    qCDebug(VIEWMANAGER) << "Reused view: " << item << ". Source QML file: " << qmlComponentFile;
+    return item;
+}
+
 void ViewManager::sendOnLayoutToJs(QQuickItem* view, float x, float y, float width, float height) {
     if (!view)
         return;
@@ -121,6 +280,23 @@ void ViewManager::sendOnLayoutToJs(QQuickItem* view, float x, float y, float wid
                        QVariantMap{{"layout", QVariantMap{{"x", x}, {"y", y}, {"width", width}, {"height", height}}}});
 }
 
+QVariantMap ViewManager::layoutEvent(QQuickItem* view, float x, float y, float width, float height) {
+    return QVariantMap{{"target", tag(view)},
+                       {"layout", QVariantMap{{"x", x}, {"y", y}, {"width", width}, {"height", height}}}};
+}
+
+void ViewManager::sendOnLayoutToJs(Bridge* bridge, const QVariantList& layoutEvents) {
+    if (!bridge)
+        return;
+
+    // Each event is dispatched on its own, like the ones sent by notifyJsAboutEvent()
+    const QString eventName = normalizeInputEventName(EVENT_ONLAYOUT);
+    for (const QVariant& layoutEvent : layoutEvents) {
+        const int target = layoutEvent.toMap().value("target").toInt();
+        bridge->enqueueJSCall("RCTEventEmitter", "receiveEvent", QVariantList{target, eventName, layoutEvent});
+    }
+}
+
 void ViewManager::requestLayoutRecalculation() {
     if (bridge() && bridge()->visualParent()) {
         bridge()->visualParent()->recalculateLayout();
@@ -128,23 +304,37 @@ void ViewManager::requestLayoutRecalculation() {
 }
 
 QQuickItem* ViewManager::createView(const QVariantMap& properties) {
-    QString qmlSrc = qmlComponentFile(properties);
-
-    if (!m_components.contains(qmlSrc)) {
-        m_components[qmlSrc] = createComponentFromSourceFile(m_bridge->qmlEngine(), QUrl(qmlSrc));
+    if (createsNativeViews()) {
+        QQuickItem* item = new ReactView;
+        if (recyclePoolCapacity(NATIVE_VIEW_COMPONENT) > 0) {
+            item->setProperty(COMPONENT_FILE_PROPERTY, NATIVE_VIEW_COMPONENT);
+        }
+        qCDebug(VIEWMANAGER) << "Created native view: " << item << ". Props keys: " << properties.keys();
+        return item;
     }
 
-    QmlComponentPtr component = m_components[qmlSrc];
-    QQuickItem* item = createQMLItemFromComponent(component);
+    QString qmlSrc = qmlComponentFile(properties);
+
+    QQuickItem* item = createQMLItemFromComponent(component(qmlSrc));
     if (item == nullptr) {
         qCCritical(VIEWMANAGER) << QString("Can't create QML item for component %1").arg(qmlSrc);
     } else {
+        if (recyclePoolCapacity(qmlSrc) > 0) {
+            item->setProperty(COMPONENT_FILE_PROPERTY, qmlSrc);
+        }
         qCDebug(VIEWMANAGER) << "Created view: " << item << ". Source QML file: " << qmlSrc
                              << ". Props keys: " << properties.keys();
     }
     return item;
 }
 
+QmlComponentPtr ViewManager::component(const QString& qmlSrc) {
+    if (!m_components.contains(qmlSrc)) {
+        m_components[qmlSrc] = createComponentFromSourceFile(m_bridge->qmlEngine(), QUrl(qmlSrc));
+    }
+    return m_components[qmlSrc];
+}
+
 Bridge* ViewManager::bridge() const {
     Q_ASSERT(m_bridge);
     return m_bridge;
@@ -20,9 +20,15 @@
 #include <QMap>
 #include <QVariant>
 
+#include <functional>
+
 Q_DECLARE_LOGGING_CATEGORY(VIEWMANAGER)
 
+// Recycle pool key of native ReactView items, which have no QML component file
+const char NATIVE_VIEW_COMPONENT[] = "ReactView";
+
 class QQuickItem;
+class QQmlIncubator;
 
 // #define QT_STATICPLUGIN
 
@@ -36,6 +42,7 @@ public:
     ~ViewManager();
 
     virtual void setBridge(Bridge* bridge) override;
+    Bridge* bridge() const;
 
     // TODO: this doesnt seem right
     virtual ViewManager* viewManager() override;
@@ -47,23 +54,57 @@ public:
 
     virtual bool shouldLayout() const;
     virtual void addChildItem(QQuickItem* parent, QQuickItem* child, int position) const;
+    // Adds children at ascending positions in one go, managers overriding addChildItem override this too
+    virtual void addChildItems(QQuickItem* parent,
+                               const QList<QQuickItem*>& children,
+                               const QList<int>& positions) const;
 
     virtual QQuickItem* view(const QVariantMap& properties = QVariantMap());
+    // Like view(), but QML components are incubated asynchronously. Callback receives
+    // nullptr if the view could not be created, and may be invoked before this returns.
+    using ViewReadyCallback = std::function<void(QQuickItem* view)>;
+    virtual void incubateView(const QVariantMap& properties, const ViewReadyCallback& callback);
     static int tag(QQuickItem* view);
 
+    // Views removed from the hierarchy are kept in a pool per QML component file (or
+    // NATIVE_VIEW_COMPONENT for native views) and reused by the next view() call for the
+    // same component. A capacity of 0 disables recycling.
+    int recyclePoolCapacity(const QString& qmlComponentFile) const;
+    void setRecyclePoolCapacity(const QString& qmlComponentFile, int capacity);
+    bool canRecycleView(QQuickItem* view) const;
+    bool recycleView(QQuickItem* view);
+
     Q_INVOKABLE void sendOnLayoutToJs(QQuickItem* view, float x, float y, float width, float height);
+    // Delivers the onLayout events of a whole layout pass, built with layoutEvent(), once its frames are committed
+    static QVariantMap layoutEvent(QQuickItem* view, float x, float y, float width, float height);
+    static void sendOnLayoutToJs(Bridge* bridge, const QVariantList& layoutEvents);
     Q_INVOKABLE void requestLayoutRecalculation();
 
 protected:
     virtual QQuickItem* createView(const QVariantMap& properties);
-    Bridge* bridge() const;
+    // Called again each time a view is taken from the recycle pool, so it must be safe to repeat
     virtual void configureView(QQuickItem* view) const;
     virtual QString qmlComponentFile(const QVariantMap& properties) const;
+    // Views of RCTView are native ReactView items created without a QML component. Subclasses which
+    // don't override qmlComponentFile() keep getting ReactView.qml views unless they opt in here.
+    virtual bool createsNativeViews() const;
     void notifyJsAboutEvent(int senderTag, const QString& eventName, const QVariantMap& eventData) const;
+    // Sends the event to js only, for events whose animated mappings were already fed natively
+    void sendEventToJs(int senderTag, const QString& eventName, const QVariantMap& eventData) const;
+    virtual void resetView(QQuickItem* view) const;
+
+private:
+    QString componentKey(const QVariantMap& properties) const;
+    utilities::QmlComponentPtr component(const QString& qmlSrc);
+    bool hasRecycledView(const QString& qmlComponentFile) const;
+    QQuickItem* takeRecycledView(const QString& qmlComponentFile);
 
 private:
     Bridge* m_bridge = nullptr;
     QMap<QString, utilities::QmlComponentPtr> m_components;
+    QMap<QString, int> m_recyclePoolCapacities;
+    QMap<QString, QList<QQuickItem*>> m_recyclePools;
+    QList<QQmlIncubator*> m_incubators;
 };
 
 #endif // VIEWMANAGER_H
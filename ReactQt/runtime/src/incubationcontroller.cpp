@@ -0,0 +1,46 @@
+
+/**
+ * Copyright (c) 2017-present, Status Research and Development GmbH.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "incubationcontroller.h"
+
+#include <QQuickWindow>
+
+IncubationController::IncubationController(QQuickWindow* window, int budget, QObject* parent)
+    : QObject(parent), m_window(window), m_budget(budget) {
+    Q_ASSERT(window);
+    connect(window, &QQuickWindow::afterAnimating, this, &IncubationController::incubate);
+}
+
+int IncubationController::budget() const {
+    return m_budget;
+}
+
+void IncubationController::setBudget(int budget) {
+    m_budget = budget;
+}
+
+void IncubationController::incubatingObjectCountChanged(int count) {
+    // Make sure a frame comes to drive incubation, even if nothing else is animating
+    if (count > 0 && m_window) {
+        m_window->update();
+    }
+}
+
+void IncubationController::incubate() {
+    if (incubatingObjectCount() == 0)
+        return;
+
+    incubateFor(m_budget);
+
+    if (incubatingObjectCount() > 0 && m_window) {
+        m_window->update();
+    }
+}
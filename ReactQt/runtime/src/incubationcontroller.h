@@ -0,0 +1,42 @@
+
+/**
+ * Copyright (c) 2017-present, Status Research and Development GmbH.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#ifndef INCUBATIONCONTROLLER_H
+#define INCUBATIONCONTROLLER_H
+
+#include <QObject>
+#include <QPointer>
+#include <QQmlIncubationController>
+
+class QQuickWindow;
+
+// Incubates asynchronously created QML objects for at most budget() msecs per frame of the window
+class IncubationController : public QObject, public QQmlIncubationController {
+    Q_OBJECT
+
+public:
+    IncubationController(QQuickWindow* window, int budget, QObject* parent = 0);
+
+    int budget() const;
+    void setBudget(int budget);
+
+protected:
+    void incubatingObjectCountChanged(int count) override;
+
+private Q_SLOTS:
+    void incubate();
+
+private:
+    QPointer<QQuickWindow> m_window;
+    int m_budget;
+};
+
+#endif // INCUBATIONCONTROLLER_H
@@ -0,0 +1,95 @@
+
+/**
+ * Copyright (c) 2017-present, Status Research and Development GmbH.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "interpolation.h"
+
+#include <algorithm>
+
+namespace {
+
+Interpolation::Extrapolate extrapolateFromString(const QVariant& value, Interpolation::Extrapolate defaultValue) {
+    const QString name = value.toString();
+    if (name == "clamp")
+        return Interpolation::Clamp;
+    if (name == "identity")
+        return Interpolation::Identity;
+    if (name == "extend")
+        return Interpolation::Extend;
+    return defaultValue;
+}
+
+QVector<double> rangeFromList(const QVariant& value) {
+    QVector<double> range;
+    for (const QVariant& v : value.toList()) {
+        range.append(v.toDouble());
+    }
+    return range;
+}
+
+} // namespace
+
+Interpolation::Interpolation(const QVector<double>& inputRange,
+                             const QVector<double>& outputRange,
+                             Extrapolate extrapolateLeft,
+                             Extrapolate extrapolateRight)
+    : m_inputRange(inputRange),
+      m_outputRange(outputRange),
+      m_extrapolateLeft(extrapolateLeft),
+      m_extrapolateRight(extrapolateRight) {}
+
+Interpolation Interpolation::fromConfig(const QVariantMap& config) {
+    const Extrapolate extrapolate = extrapolateFromString(config.value("extrapolate"), Extend);
+    return Interpolation(rangeFromList(config.value("inputRange")),
+                         rangeFromList(config.value("outputRange")),
+                         extrapolateFromString(config.value("extrapolateLeft"), extrapolate),
+                         extrapolateFromString(config.value("extrapolateRight"), extrapolate));
+}
+
+bool Interpolation::isValid() const {
+    return m_inputRange.size() >= 2 && m_inputRange.size() == m_outputRange.size() &&
+           std::is_sorted(m_inputRange.constBegin(), m_inputRange.constEnd());
+}
+
+double Interpolation::evaluate(double input) const {
+    if (!isValid())
+        return input;
+
+    // Segment whose end is the first input range value not below input, or the last one
+    int segment = 1;
+    while (segment < m_inputRange.size() - 1 && m_inputRange.at(segment) < input) {
+        ++segment;
+    }
+    const double inputMin = m_inputRange.at(segment - 1);
+    const double inputMax = m_inputRange.at(segment);
+    const double outputMin = m_outputRange.at(segment - 1);
+    const double outputMax = m_outputRange.at(segment);
+
+    double result = input;
+    if (result < inputMin) {
+        if (m_extrapolateLeft == Identity)
+            return result;
+        if (m_extrapolateLeft == Clamp)
+            result = inputMin;
+    }
+    if (result > inputMax) {
+        if (m_extrapolateRight == Identity)
+            return result;
+        if (m_extrapolateRight == Clamp)
+            result = inputMax;
+    }
+
+    if (outputMin == outputMax)
+        return outputMin;
+    if (inputMin == inputMax)
+        return input <= inputMin ? outputMin : outputMax;
+
+    return outputMin + (result - inputMin) / (inputMax - inputMin) * (outputMax - outputMin);
+}
@@ -0,0 +1,44 @@
+
+/**
+ * Copyright (c) 2017-present, Status Research and Development GmbH.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#ifndef INTERPOLATION_H
+#define INTERPOLATION_H
+
+#include <QVariantMap>
+#include <QVector>
+
+// Piecewise linear mapping with the semantics of Animated's interpolate()
+class Interpolation {
+public:
+    enum Extrapolate { Extend, Clamp, Identity };
+
+    Interpolation() = default;
+    Interpolation(const QVector<double>& inputRange,
+                  const QVector<double>& outputRange,
+                  Extrapolate extrapolateLeft = Extend,
+                  Extrapolate extrapolateRight = Extend);
+
+    // Reads inputRange, outputRange and extrapolate, extrapolateLeft or extrapolateRight
+    // ("extend", "clamp" or "identity") of an interpolate() config
+    static Interpolation fromConfig(const QVariantMap& config);
+
+    // Ranges have the same size of at least 2, with an ascending input range
+    bool isValid() const;
+    double evaluate(double input) const;
+
+private:
+    QVector<double> m_inputRange;
+    QVector<double> m_outputRange;
+    Extrapolate m_extrapolateLeft = Extend;
+    Extrapolate m_extrapolateRight = Extend;
+};
+
+#endif // INTERPOLATION_H
@@ -0,0 +1,393 @@
+
+/**
+ * Copyright (c) 2017-present, Status Research and Development GmbH.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#ifdef JAVASCRIPTCORE_ENABLED
+
+#include "jscmodulebindings.h"
+
+#include <memory>
+
+#include <QLoggingCategory>
+#include <QPointer>
+#include <QVector>
+
+#include "bridge.h"
+#include "moduledata.h"
+#include "moduleinterface.h"
+#include "modulemethod.h"
+#include "valuecoercion.h"
+
+Q_LOGGING_CATEGORY(JSCBINDINGS, "JSCModuleBindings")
+
+namespace {
+
+struct MethodBinding {
+    Bridge* bridge;
+    QPointer<ModuleMethod> method;
+    JSGlobalContextRef context;
+};
+
+QString jsStringToQString(JSStringRef string) {
+    return QString(reinterpret_cast<const QChar*>(JSStringGetCharactersPtr(string)),
+                   static_cast<int>(JSStringGetLength(string)));
+}
+
+JSStringRef qStringToJSString(const QString& string) {
+    return JSStringCreateWithCharacters(reinterpret_cast<const JSChar*>(string.utf16()), string.size());
+}
+
+void setProperty(JSContextRef ctx, JSObjectRef object, const QString& name, JSValueRef value) {
+    JSStringRef jsName = qStringToJSString(name);
+    JSObjectSetProperty(ctx, object, jsName, value, kJSPropertyAttributeNone, nullptr);
+    JSStringRelease(jsName);
+}
+
+QVariant jsValueToVariant(JSContextRef ctx, JSValueRef value) {
+    switch (JSValueGetType(ctx, value)) {
+    case kJSTypeBoolean:
+        return JSValueToBoolean(ctx, value);
+    case kJSTypeNumber:
+        return JSValueToNumber(ctx, value, nullptr);
+    case kJSTypeString: {
+        JSStringRef string = JSValueToStringCopy(ctx, value, nullptr);
+        QString result = jsStringToQString(string);
+        JSStringRelease(string);
+        return result;
+    }
+    case kJSTypeObject: {
+        JSObjectRef object = JSValueToObject(ctx, value, nullptr);
+        if (JSValueIsArray(ctx, value)) {
+            JSStringRef lengthName = JSStringCreateWithUTF8CString("length");
+            unsigned length = JSValueToNumber(ctx, JSObjectGetProperty(ctx, object, lengthName, nullptr), nullptr);
+            JSStringRelease(lengthName);
+
+            QVariantList list;
+            list.reserve(length);
+            for (unsigned i = 0; i < length; ++i) {
+                list.push_back(jsValueToVariant(ctx, JSObjectGetPropertyAtIndex(ctx, object, i, nullptr)));
+            }
+            return list;
+        }
+
+        QVariantMap map;
+        JSPropertyNameArrayRef names = JSObjectCopyPropertyNames(ctx, object);
+        const size_t count = JSPropertyNameArrayGetCount(names);
+        for (size_t i = 0; i < count; ++i) {
+            JSStringRef name = JSPropertyNameArrayGetNameAtIndex(names, i);
+            map.insert(jsStringToQString(name), jsValueToVariant(ctx, JSObjectGetProperty(ctx, object, name, nullptr)));
+        }
+        JSPropertyNameArrayRelease(names);
+        return map;
+    }
+    default:
+        return QVariant();
+    }
+}
+
+JSValueRef variantToJSValue(JSContextRef ctx, const QVariant& value) {
+    switch (value.type()) {
+    case QMetaType::UnknownType:
+        return JSValueMakeNull(ctx);
+    case QMetaType::Bool:
+        return JSValueMakeBoolean(ctx, value.toBool());
+    case QMetaType::Int:
+    case QMetaType::UInt:
+    case QMetaType::LongLong:
+    case QMetaType::ULongLong:
+    case QMetaType::Float:
+    case QMetaType::Double:
+        return JSValueMakeNumber(ctx, value.toDouble());
+    case QMetaType::QVariantList:
+    case QMetaType::QStringList: {
+        QVariantList list = value.toList();
+        QVector<JSValueRef> elements;
+        elements.reserve(list.size());
+        for (const QVariant& element : list) {
+            elements.push_back(variantToJSValue(ctx, element));
+        }
+        return JSObjectMakeArray(ctx, elements.size(), elements.constData(), nullptr);
+    }
+    case QMetaType::QVariantMap: {
+        JSObjectRef object = JSObjectMake(ctx, nullptr, nullptr);
+        QVariantMap map = value.toMap();
+        for (auto it = map.constBegin(); it != map.constEnd(); ++it) {
+            setProperty(ctx, object, it.key(), variantToJSValue(ctx, it.value()));
+        }
+        return object;
+    }
+    default:
+        break;
+    }
+
+    if (value.canConvert<QString>()) {
+        JSStringRef string = qStringToJSString(value.toString());
+        JSValueRef result = JSValueMakeString(ctx, string);
+        JSStringRelease(string);
+        return result;
+    }
+    return JSValueMakeUndefined(ctx);
+}
+
+JSValueRef globalProperty(JSContextRef ctx, const char* name) {
+    JSStringRef jsName = JSStringCreateWithUTF8CString(name);
+    JSValueRef value = JSObjectGetProperty(ctx, JSContextGetGlobalObject(ctx), jsName, nullptr);
+    JSStringRelease(jsName);
+    return value;
+}
+
+JSObjectRef objectMethod(JSContextRef ctx, JSValueRef object, const char* name) {
+    if (!JSValueIsObject(ctx, object))
+        return nullptr;
+    JSStringRef jsName = JSStringCreateWithUTF8CString(name);
+    JSValueRef value = JSObjectGetProperty(ctx, JSValueToObject(ctx, object, nullptr), jsName, nullptr);
+    JSStringRelease(jsName);
+    if (!JSValueIsObject(ctx, value) || !JSObjectIsFunction(ctx, JSValueToObject(ctx, value, nullptr)))
+        return nullptr;
+    return JSValueToObject(ctx, value, nullptr);
+}
+
+// Same as MessageQueue does for errors thrown by the functions it calls
+void reportException(JSContextRef ctx, JSValueRef exception) {
+    JSValueRef errorUtils = globalProperty(ctx, "ErrorUtils");
+    JSObjectRef reportFatalError = objectMethod(ctx, errorUtils, "reportFatalError");
+    if (reportFatalError) {
+        JSValueRef reportException = nullptr;
+        JSObjectCallAsFunction(ctx,
+                               reportFatalError,
+                               JSValueToObject(ctx, errorUtils, nullptr),
+                               1,
+                               &exception,
+                               &reportException);
+        if (!reportException)
+            return;
+        exception = reportException;
+    }
+
+    JSStringRef message = JSValueToStringCopy(ctx, exception, nullptr);
+    qCCritical(JSCBINDINGS) << "Unhandled JS exception:" << (message ? jsStringToQString(message) : QString());
+    if (message)
+        JSStringRelease(message);
+}
+
+// Calls made by js while it ran outside of a batched call, e.g. in a callback, are only
+// sent with the next batch. They are flushed right away, as invokeCallbackAndReturnFlushedQueue does.
+void flushQueue(JSContextRef ctx, Bridge* bridge) {
+    JSValueRef batchedBridge = globalProperty(ctx, "__fbBatchedBridge");
+    JSObjectRef flushedQueue = objectMethod(ctx, batchedBridge, "flushedQueue");
+    if (!flushedQueue)
+        return;
+
+    JSValueRef exception = nullptr;
+    JSValueRef queue =
+        JSObjectCallAsFunction(ctx, flushedQueue, JSValueToObject(ctx, batchedBridge, nullptr), 0, nullptr, &exception);
+    if (exception) {
+        reportException(ctx, exception);
+        return;
+    }
+    if (queue && JSValueIsArray(ctx, queue)) {
+        bridge->enqueueNativeCalls(jsValueToVariant(ctx, queue).toList());
+    }
+}
+
+// Keeps a JS function alive for as long as the native side holds a block for it.
+// Must be destroyed on the JavaScript thread while the bridge is alive, see makeCallback().
+class JSCallback {
+public:
+    JSCallback(Bridge* bridge, JSGlobalContextRef context, JSObjectRef function)
+        : m_bridge(bridge), m_context(context), m_function(function) {
+        JSGlobalContextRetain(m_context);
+        JSValueProtect(m_context, m_function);
+    }
+    ~JSCallback() {
+        JSValueUnprotect(m_context, m_function);
+        JSGlobalContextRelease(m_context);
+    }
+
+    void call(const QVariantList& args) const {
+        QVector<JSValueRef> jsArgs;
+        jsArgs.reserve(args.size());
+        for (const QVariant& arg : args) {
+            jsArgs.push_back(variantToJSValue(m_context, arg));
+        }
+        JSValueRef exception = nullptr;
+        JSObjectCallAsFunction(m_context, m_function, nullptr, jsArgs.size(), jsArgs.constData(), &exception);
+        if (exception) {
+            reportException(m_context, exception);
+        }
+        if (m_bridge) {
+            flushQueue(m_context, m_bridge);
+        }
+    }
+
+private:
+    QPointer<Bridge> m_bridge;
+    JSGlobalContextRef m_context;
+    JSObjectRef m_function;
+};
+
+std::shared_ptr<JSCallback> makeCallback(const MethodBinding* binding, JSContextRef ctx, JSValueRef value) {
+    QPointer<Bridge> bridge = binding->bridge;
+    // The last block holding the callback may be released on any thread, so it's unprotected
+    // on the JS thread. Once the bridge is gone no JS runs anymore, and the context is kept
+    // alive by the callback, so it's deleted right away rather than leaked.
+    return std::shared_ptr<JSCallback>(
+        new JSCallback(binding->bridge, binding->context, JSValueToObject(ctx, value, nullptr)),
+        [bridge](JSCallback* callback) {
+            if (bridge) {
+                bridge->executeOnJavaScriptThread([callback] { delete callback; });
+            } else {
+                delete callback;
+            }
+        });
+}
+
+QVariant jsValueToArgument(const MethodBinding* binding, JSContextRef ctx, JSValueRef value, int parameterType) {
+    const bool isFunction =
+        JSValueIsObject(ctx, value) && JSObjectIsFunction(ctx, JSValueToObject(ctx, value, nullptr));
+
+    if (isFunction && parameterType == qMetaTypeId<ModuleInterface::ListArgumentBlock>()) {
+        auto callback = makeCallback(binding, ctx, value);
+        ModuleInterface::ListArgumentBlock block = [callback](Bridge* bridge, const QVariantList& args) {
+            bridge->executeOnJavaScriptThread([callback, args] { callback->call(args); });
+        };
+        return QVariant::fromValue(block);
+    }
+
+    if (isFunction && parameterType == qMetaTypeId<ModuleInterface::MapArgumentBlock>()) {
+        auto callback = makeCallback(binding, ctx, value);
+        ModuleInterface::MapArgumentBlock block = [callback](Bridge* bridge, const QVariantMap& arg) {
+            bridge->executeOnJavaScriptThread([callback, arg] { callback->call(QVariantList{arg}); });
+        };
+        return QVariant::fromValue(block);
+    }
+
+    return reactCoerceValue(jsValueToVariant(ctx, value), parameterType);
+}
+
+JSValueRef throwError(JSContextRef ctx, const QString& message, JSValueRef* exception) {
+    if (exception) {
+        JSValueRef messageValue = variantToJSValue(ctx, message);
+        *exception = JSObjectMakeError(ctx, 1, &messageValue, nullptr);
+    }
+    return JSValueMakeUndefined(ctx);
+}
+
+JSValueRef callMethod(JSContextRef ctx,
+                      JSObjectRef function,
+                      JSObjectRef /*thisObject*/,
+                      size_t argumentCount,
+                      const JSValueRef arguments[],
+                      JSValueRef* exception) {
+    const MethodBinding* binding = static_cast<MethodBinding*>(JSObjectGetPrivate(function));
+    if (!binding || !binding->method) {
+        return throwError(ctx, "Native method is no longer available", exception);
+    }
+
+    ModuleMethod* method = binding->method;
+    const int parameterCount = method->parameterCount();
+    if (argumentCount != static_cast<size_t>(parameterCount)) {
+        return throwError(
+            ctx,
+            QString("%1 expects %2 arguments, got %3").arg(method->name()).arg(parameterCount).arg(argumentCount),
+            exception);
+    }
+
+    // JSValueRefs are only valid on the JS thread, so arguments are converted
+    // to the target parameter types here and only the call itself is posted
+    QVariantList args;
+    args.reserve(parameterCount);
+    for (int i = 0; i < parameterCount; ++i) {
+        args.push_back(jsValueToArgument(binding, ctx, arguments[i], method->parameterType(i)));
+    }
+
+    binding->bridge->enqueueNativeCall(method, args);
+
+    return JSValueMakeUndefined(ctx);
+}
+
+// Replaces the hook cxxreact installs, so batches MessageQueue flushes early, e.g. before
+// a host object call, run from the bridge's queue in order with the direct calls
+JSValueRef flushQueueImmediate(JSContextRef ctx,
+                               JSObjectRef function,
+                               JSObjectRef /*thisObject*/,
+                               size_t argumentCount,
+                               const JSValueRef arguments[],
+                               JSValueRef* exception) {
+    Bridge* bridge = static_cast<Bridge*>(JSObjectGetPrivate(function));
+    if (!bridge || argumentCount != 1) {
+        return throwError(ctx, "nativeFlushQueueImmediate expects a queue", exception);
+    }
+    bridge->enqueueNativeCalls(jsValueToVariant(ctx, arguments[0]).toList());
+    return JSValueMakeUndefined(ctx);
+}
+
+void finalizeMethod(JSObjectRef object) {
+    delete static_cast<MethodBinding*>(JSObjectGetPrivate(object));
+}
+
+JSClassRef flushQueueClass() {
+    static JSClassRef jsClass = nullptr;
+    if (!jsClass) {
+        JSClassDefinition definition = kJSClassDefinitionEmpty;
+        definition.className = "NativeFlushQueue";
+        definition.callAsFunction = flushQueueImmediate;
+        jsClass = JSClassCreate(&definition);
+    }
+    return jsClass;
+}
+
+JSClassRef methodClass() {
+    static JSClassRef jsClass = nullptr;
+    if (!jsClass) {
+        JSClassDefinition definition = kJSClassDefinitionEmpty;
+        definition.className = "NativeMethod";
+        definition.callAsFunction = callMethod;
+        definition.finalize = finalizeMethod;
+        jsClass = JSClassCreate(&definition);
+    }
+    return jsClass;
+}
+
+} // namespace
+
+namespace utilities {
+
+void installModuleBindings(JSGlobalContextRef context, Bridge* bridge) {
+    Q_ASSERT(context && bridge);
+
+    JSObjectRef modulesObject = JSObjectMake(context, nullptr, nullptr);
+
+    for (ModuleData* moduleData : bridge->modules()) {
+        JSObjectRef moduleObject = JSObjectMake(context, nullptr, nullptr);
+
+        const QVariantMap constants = moduleData->constants();
+        for (auto it = constants.constBegin(); it != constants.constEnd(); ++it) {
+            setProperty(context, moduleObject, it.key(), variantToJSValue(context, it.value()));
+        }
+
+        for (int i = 0; i < moduleData->methodCount(); ++i) {
+            ModuleMethod* method = moduleData->method(i);
+            JSObjectRef methodObject = JSObjectMake(context, methodClass(), new MethodBinding{bridge, method, context});
+            setProperty(context, moduleObject, method->name(), methodObject);
+        }
+
+        // Same naming as in the module config injected into __fbBatchedBridgeConfig
+        setProperty(context, modulesObject, moduleData->name().replace("RCT", ""), moduleObject);
+    }
+
+    JSObjectRef globalObject = JSContextGetGlobalObject(context);
+    setProperty(context, globalObject, JSC_NATIVE_MODULES_GLOBAL, modulesObject);
+    setProperty(context, globalObject, "nativeFlushQueueImmediate", JSObjectMake(context, flushQueueClass(), bridge));
+}
+
+} // namespace utilities
+
+#endif // JAVASCRIPTCORE_ENABLED
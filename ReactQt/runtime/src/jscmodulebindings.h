@@ -0,0 +1,38 @@
+
+/**
+ * Copyright (c) 2017-present, Status Research and Development GmbH.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#ifndef JSCMODULEBINDINGS_H
+#define JSCMODULEBINDINGS_H
+
+#ifdef JAVASCRIPTCORE_ENABLED
+
+#include <JavaScriptCore/JavaScript.h>
+
+class Bridge;
+
+namespace utilities {
+
+// Name of the global object that holds a host object per native module.
+// Every exported method is a native function, so JS can call into a module
+// without a JSON round trip, e.g.
+// global.__qtNativeModules.UIManager.updateView(tag, "RCTView", props)
+// QtHostModules.desktop-qt.js routes the async and promise methods of NativeModules through them.
+// The calls run from the bridge's native call queue, in order with the batched ones.
+const char JSC_NATIVE_MODULES_GLOBAL[] = "__qtNativeModules";
+
+// Must be called on the JavaScript thread, after the bridge modules are created
+void installModuleBindings(JSGlobalContextRef context, Bridge* bridge);
+
+} // namespace utilities
+
+#endif // JAVASCRIPTCORE_ENABLED
+
+#endif // JSCMODULEBINDINGS_H
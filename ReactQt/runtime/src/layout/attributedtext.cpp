@@ -0,0 +1,162 @@
+
+/**
+ * Copyright (c) 2017-present, Status Research and Development GmbH.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "attributedtext.h"
+
+#include <QFont>
+#include <QHash>
+#include <QTextCursor>
+#include <QTextDocument>
+
+namespace {
+
+uint combineHash(uint hash, uint value) {
+    return hash * 31 + value;
+}
+
+// CSS font weights, the way Qt's HTML importer maps them
+int fontWeightValue(const QString& weight) {
+    if (weight == "bold")
+        return QFont::Bold;
+    if (weight == "normal")
+        return QFont::Normal;
+
+    switch (weight.toInt()) {
+    case 100:
+        return QFont::Thin;
+    case 200:
+        return QFont::ExtraLight;
+    case 300:
+        return QFont::Light;
+    case 500:
+        return QFont::Medium;
+    case 600:
+        return QFont::DemiBold;
+    case 700:
+        return QFont::Bold;
+    case 800:
+        return QFont::ExtraBold;
+    case 900:
+        return QFont::Black;
+    default:
+        return QFont::Normal;
+    }
+}
+
+} // namespace
+
+QTextCharFormat TextStyle::charFormat() const {
+    QTextCharFormat format;
+    if (!fontFamily.isEmpty()) {
+        format.setFontFamily(fontFamily);
+    }
+    if (fontSize > 0) {
+        format.setFontPointSize(fontSize);
+    }
+    if (color.isValid()) {
+        format.setForeground(color);
+    }
+    if (backgroundColor.isValid() && backgroundColor.alpha() != 0) {
+        format.setBackground(backgroundColor);
+    }
+    if (fontStyle == "italic" || fontStyle == "oblique") {
+        format.setFontItalic(true);
+    }
+    if (!fontWeight.isEmpty()) {
+        format.setFontWeight(fontWeightValue(fontWeight));
+    }
+    if (textDecorationLine.contains("underline")) {
+        format.setFontUnderline(true);
+    }
+    if (textDecorationLine.contains("line-through")) {
+        format.setFontStrikeOut(true);
+    }
+    return format;
+}
+
+uint TextStyle::hash() const {
+    uint hash = qHash(fontFamily);
+    hash = combineHash(hash, qHash(fontSize));
+    hash = combineHash(hash, color.rgba());
+    hash = combineHash(hash, backgroundColor.rgba());
+    hash = combineHash(hash, qHash(fontStyle));
+    hash = combineHash(hash, qHash(fontWeight));
+    return combineHash(hash, qHash(textDecorationLine));
+}
+
+void AttributedText::append(const QString& text, const TextStyle& style) {
+    if (text.isEmpty())
+        return;
+
+    QTextLayout::FormatRange range;
+    range.start = m_text.length();
+    range.length = text.length();
+    range.format = style.charFormat();
+
+    m_text += text;
+    m_formats.push_back(range);
+    m_hash = combineHash(combineHash(m_hash, qHash(text)), style.hash());
+}
+
+void AttributedText::append(const AttributedText& nested, const QString& anchorHref) {
+    if (nested.isEmpty())
+        return;
+
+    const int offset = m_text.length();
+    for (QTextLayout::FormatRange range : nested.m_formats) {
+        range.start += offset;
+        range.format.setAnchor(true);
+        range.format.setAnchorHref(anchorHref);
+        m_formats.push_back(range);
+    }
+
+    m_text += nested.m_text;
+    m_hash = combineHash(combineHash(m_hash, nested.m_hash), qHash(anchorHref));
+}
+
+const QString& AttributedText::text() const {
+    return m_text;
+}
+
+const QVector<QTextLayout::FormatRange>& AttributedText::formats() const {
+    return m_formats;
+}
+
+uint AttributedText::hash() const {
+    return m_hash;
+}
+
+bool AttributedText::isEmpty() const {
+    return m_text.isEmpty();
+}
+
+void AttributedText::applyTo(QTextDocument* document) const {
+    Q_ASSERT(document);
+
+    document->setUndoRedoEnabled(false);
+    document->clear();
+
+    QTextCursor cursor(document);
+    cursor.beginEditBlock();
+    for (const QTextLayout::FormatRange& range : m_formats) {
+        // Line breaks start new blocks, the same as <br> did in the generated HTML
+        cursor.insertText(m_text.mid(range.start, range.length), range.format);
+    }
+    cursor.endEditBlock();
+}
+
+bool AttributedText::operator==(const AttributedText& other) const {
+    return m_hash == other.m_hash && m_text == other.m_text && m_formats == other.m_formats;
+}
+
+bool AttributedText::operator!=(const AttributedText& other) const {
+    return !(*this == other);
+}
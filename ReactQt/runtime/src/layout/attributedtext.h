@@ -0,0 +1,65 @@
+
+/**
+ * Copyright (c) 2017-present, Status Research and Development GmbH.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#ifndef ATTRIBUTEDTEXT_H
+#define ATTRIBUTEDTEXT_H
+
+#include <QColor>
+#include <QString>
+#include <QTextCharFormat>
+#include <QTextLayout>
+#include <QVector>
+
+class QTextDocument;
+
+// Style props of a ReactText, as resolved from the item and its text parents
+struct TextStyle {
+    QString fontFamily;
+    double fontSize = 0;
+    QColor color;
+    QColor backgroundColor;
+    QString fontStyle;
+    QString fontWeight;
+    QString textDecorationLine;
+
+    QTextCharFormat charFormat() const;
+    uint hash() const;
+};
+
+// Plain text of a text block with the format ranges of its nested texts.
+//
+// Built natively from the text items instead of generating HTML for the
+// TextEdit to parse. Implicitly shared, so copies can be handed over to the
+// layout thread for measurement.
+class AttributedText {
+public:
+    void append(const QString& text, const TextStyle& style);
+    // Appends a nested text, which is hit tested through anchorHref
+    void append(const AttributedText& nested, const QString& anchorHref);
+
+    const QString& text() const;
+    const QVector<QTextLayout::FormatRange>& formats() const;
+    uint hash() const;
+    bool isEmpty() const;
+
+    // Replaces the contents of document, the default font and text options are left as they are
+    void applyTo(QTextDocument* document) const;
+
+    bool operator==(const AttributedText& other) const;
+    bool operator!=(const AttributedText& other) const;
+
+private:
+    QString m_text;
+    QVector<QTextLayout::FormatRange> m_formats;
+    uint m_hash = 0;
+};
+
+#endif // ATTRIBUTEDTEXT_H
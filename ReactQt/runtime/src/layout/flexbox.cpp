@@ -11,15 +11,23 @@
 
 #include "flexbox.h"
 #include "attachedproperties.h"
+#include "bridge.h"
 #include "componentmanagers/viewmanager.h"
+#include "layoutthread.h"
+
+#include "../../../ReactCommon/yoga/yoga/YGNode.h"
 
 #include <QDebug>
-#include <QMap>
+#include <QHash>
 #include <QQuickItem>
+#include <QVarLengthArray>
+#include <QVector>
+
+#include <deque>
 
 Q_LOGGING_CATEGORY(FLEXBOX, "Flexbox")
 
-static QMap<QString, YGFlexDirection> flexDirectionByString{
+static QHash<QString, YGFlexDirection> flexDirectionByString{
     {"row", YGFlexDirectionRow},
     {"row-reverse", YGFlexDirectionRowReverse},
     {"column", YGFlexDirectionColumn},
@@ -27,7 +35,7 @@ static QMap<QString, YGFlexDirection> flexDirectionByString{
     {"", YGFlexDirectionColumn},
 };
 
-static QMap<QString, YGJustify> justificationByString{
+static QHash<QString, YGJustify> justificationByString{
     {"flex-start", YGJustifyFlexStart},
     {"flex-end", YGJustifyFlexEnd},
     {"center", YGJustifyCenter},
@@ -36,37 +44,429 @@ static QMap<QString, YGJustify> justificationByString{
     {"", YGJustifyFlexStart},
 };
 
-static QMap<QString, YGAlign> alignByString{{"flex-start", YGAlignFlexStart},
-                                            {"flex-end", YGAlignFlexEnd},
-                                            {"center", YGAlignCenter},
-                                            {"stretch", YGAlignStretch},
-                                            {"baseline", YGAlignBaseline},
-                                            {"space-between", YGAlignSpaceBetween},
-                                            {"space-around", YGAlignSpaceAround},
-                                            {"", YGAlignStretch}};
+static QHash<QString, YGAlign> alignByString{{"flex-start", YGAlignFlexStart},
+                                             {"flex-end", YGAlignFlexEnd},
+                                             {"center", YGAlignCenter},
+                                             {"stretch", YGAlignStretch},
+                                             {"baseline", YGAlignBaseline},
+                                             {"space-between", YGAlignSpaceBetween},
+                                             {"space-around", YGAlignSpaceAround},
+                                             {"", YGAlignStretch}};
 
-static QMap<QString, YGWrap> wrapByString{
+static QHash<QString, YGWrap> wrapByString{
     {"wrap", YGWrapWrap}, {"nowrap", YGWrapNoWrap}, {"", YGWrapNoWrap},
 };
 
-static QMap<QString, YGDisplay> displayByString{
+static QHash<QString, YGDisplay> displayByString{
     {"none", YGDisplayNone}, {"flex", YGDisplayFlex}, {"", YGDisplayFlex},
 };
 
-static QMap<QString, YGOverflow> overflowByString{
+static QHash<QString, YGOverflow> overflowByString{
     {"visible", YGOverflowVisible}, {"hidden", YGOverflowHidden}, {"scroll", YGOverflowScroll}, {"", YGOverflowVisible},
 };
 
-static QMap<QString, YGPositionType> positionByString{
+static QHash<QString, YGPositionType> positionByString{
     {"relative", YGPositionTypeRelative}, {"absolute", YGPositionTypeAbsolute}, {"", YGPositionTypeRelative},
 };
 
-static QMap<QString, YGDirection> directionByString{
+static QHash<QString, YGDirection> directionByString{
     {"inherit", YGDirectionInherit}, {"ltr", YGDirectionLTR}, {"rtl", YGDirectionRTL}, {"", YGDirectionInherit},
 };
 
 const char LAYOUT_UPDATED_SIGNAL_NAME[] = "layoutUpdated";
 
+namespace {
+
+// Style props js sets on views. applyStyle() decodes their values once and dispatches
+// on the id straight to the Yoga node, without the meta object or the notifying setters.
+enum StyleProp {
+    // Points, percents or auto
+    StyleWidth,
+    StyleHeight,
+    StyleMinWidth,
+    StyleMinHeight,
+    StyleMaxWidth,
+    StyleMaxHeight,
+    StyleFlexBasis,
+    StyleMargin,
+    StyleMarginTop,
+    StyleMarginBottom,
+    StyleMarginLeft,
+    StyleMarginRight,
+    StyleMarginHorizontal,
+    StyleMarginVertical,
+    StylePadding,
+    StylePaddingTop,
+    StylePaddingBottom,
+    StylePaddingLeft,
+    StylePaddingRight,
+    StylePaddingHorizontal,
+    StylePaddingVertical,
+    StyleTop,
+    StyleBottom,
+    StyleLeft,
+    StyleRight,
+    // Plain numbers
+    StyleBorderWidth,
+    StyleBorderTopWidth,
+    StyleBorderBottomWidth,
+    StyleBorderLeftWidth,
+    StyleBorderRightWidth,
+    StyleFlex,
+    StyleFlexGrow,
+    StyleFlexShrink,
+    StyleAspectRatio,
+    // Keywords
+    StyleFlexDirection,
+    StyleJustifyContent,
+    StyleAlignItems,
+    StyleAlignContent,
+    StyleAlignSelf,
+    StyleFlexWrap,
+    StyleDisplay,
+    StyleOverflow,
+    StylePosition,
+    StyleDirection,
+    // Flags
+    StyleOnLayout
+};
+
+const QHash<QString, StyleProp>& stylePropsByName() {
+    static const QHash<QString, StyleProp> props{
+        {"width", StyleWidth},
+        {"height", StyleHeight},
+        {"minWidth", StyleMinWidth},
+        {"minHeight", StyleMinHeight},
+        {"maxWidth", StyleMaxWidth},
+        {"maxHeight", StyleMaxHeight},
+        {"flexBasis", StyleFlexBasis},
+        {"margin", StyleMargin},
+        {"marginTop", StyleMarginTop},
+        {"marginBottom", StyleMarginBottom},
+        {"marginLeft", StyleMarginLeft},
+        {"marginRight", StyleMarginRight},
+        {"marginHorizontal", StyleMarginHorizontal},
+        {"marginVertical", StyleMarginVertical},
+        {"padding", StylePadding},
+        {"paddingTop", StylePaddingTop},
+        {"paddingBottom", StylePaddingBottom},
+        {"paddingLeft", StylePaddingLeft},
+        {"paddingRight", StylePaddingRight},
+        {"paddingHorizontal", StylePaddingHorizontal},
+        {"paddingVertical", StylePaddingVertical},
+        {"top", StyleTop},
+        {"bottom", StyleBottom},
+        {"left", StyleLeft},
+        {"right", StyleRight},
+        {"borderWidth", StyleBorderWidth},
+        {"borderTopWidth", StyleBorderTopWidth},
+        {"borderBottomWidth", StyleBorderBottomWidth},
+        {"borderLeftWidth", StyleBorderLeftWidth},
+        {"borderRightWidth", StyleBorderRightWidth},
+        {"flex", StyleFlex},
+        {"flexGrow", StyleFlexGrow},
+        {"flexShrink", StyleFlexShrink},
+        {"aspectRatio", StyleAspectRatio},
+        {"flexDirection", StyleFlexDirection},
+        {"justifyContent", StyleJustifyContent},
+        {"alignItems", StyleAlignItems},
+        {"alignContent", StyleAlignContent},
+        {"alignSelf", StyleAlignSelf},
+        {"flexWrap", StyleFlexWrap},
+        {"display", StyleDisplay},
+        {"overflow", StyleOverflow},
+        {"position", StylePosition},
+        {"direction", StyleDirection},
+        {"onLayout", StyleOnLayout},
+    };
+    return props;
+}
+
+YGEdge styleEdge(StyleProp prop) {
+    switch (prop) {
+    case StyleMarginTop:
+    case StylePaddingTop:
+    case StyleBorderTopWidth:
+    case StyleTop:
+        return YGEdgeTop;
+    case StyleMarginBottom:
+    case StylePaddingBottom:
+    case StyleBorderBottomWidth:
+    case StyleBottom:
+        return YGEdgeBottom;
+    case StyleMarginLeft:
+    case StylePaddingLeft:
+    case StyleBorderLeftWidth:
+    case StyleLeft:
+        return YGEdgeLeft;
+    case StyleMarginRight:
+    case StylePaddingRight:
+    case StyleBorderRightWidth:
+    case StyleRight:
+        return YGEdgeRight;
+    case StyleMarginHorizontal:
+    case StylePaddingHorizontal:
+        return YGEdgeHorizontal;
+    case StyleMarginVertical:
+    case StylePaddingVertical:
+        return YGEdgeVertical;
+    default:
+        return YGEdgeAll;
+    }
+}
+
+// Reset props (null values) are undefined, which Yoga lays out as the default
+YGValue decodeDimension(const QVariant& value) {
+    if (value.isNull())
+        return YGValueUndefined;
+    // Numbers, by far the most common values, are points
+    if (value.type() != QMetaType::QString)
+        return YGValue{value.toFloat(), YGUnitPoint};
+
+    const QString string = value.toString();
+    if (string == "auto")
+        return YGValueAuto;
+
+    bool success = false;
+    if (string.endsWith('%')) {
+        const float percents = string.leftRef(string.size() - 1).toFloat(&success);
+        if (success)
+            return YGValue{percents, YGUnitPercent};
+    } else {
+        const float points = string.toFloat(&success);
+        if (success)
+            return YGValue{points, YGUnitPoint};
+    }
+    qCDebug(FLEXBOX) << "Unable to parse value " << string;
+    return YGValueUndefined;
+}
+
+template <typename Enum>
+int decodeKeyword(const QHash<QString, Enum>& keywords, const QString& keyword) {
+    auto it = keywords.constFind(keyword);
+    if (it == keywords.constEnd()) {
+        qCDebug(FLEXBOX) << "Unable to parse value " << keyword;
+        return keywords.value(QString());
+    }
+    return *it;
+}
+
+int decodeKeyword(StyleProp prop, const QString& keyword) {
+    switch (prop) {
+    case StyleFlexDirection:
+        return decodeKeyword(flexDirectionByString, keyword);
+    case StyleJustifyContent:
+        return decodeKeyword(justificationByString, keyword);
+    case StyleAlignItems:
+    case StyleAlignContent:
+    case StyleAlignSelf:
+        return decodeKeyword(alignByString, keyword);
+    case StyleFlexWrap:
+        return decodeKeyword(wrapByString, keyword);
+    case StyleDisplay:
+        return decodeKeyword(displayByString, keyword);
+    case StyleOverflow:
+        return decodeKeyword(overflowByString, keyword);
+    case StylePosition:
+        return decodeKeyword(positionByString, keyword);
+    case StyleDirection:
+        return decodeKeyword(directionByString, keyword);
+    default:
+        return 0;
+    }
+}
+
+typedef void (*PointsSetter)(YGNodeRef, float);
+typedef void (*AutoSetter)(YGNodeRef);
+typedef void (*EdgePointsSetter)(YGNodeRef, YGEdge, float);
+typedef void (*EdgeAutoSetter)(YGNodeRef, YGEdge);
+
+void setDimension(YGNodeRef node,
+                  const YGValue& value,
+                  PointsSetter points,
+                  PointsSetter percent,
+                  AutoSetter autoSize) {
+    if (value.unit == YGUnitPercent) {
+        percent(node, value.value);
+    } else if (value.unit == YGUnitAuto && autoSize) {
+        autoSize(node);
+    } else {
+        points(node, value.unit == YGUnitPoint ? value.value : YGUndefined);
+    }
+}
+
+void setEdgeDimension(YGNodeRef node,
+                      YGEdge edge,
+                      const YGValue& value,
+                      EdgePointsSetter points,
+                      EdgePointsSetter percent,
+                      EdgeAutoSetter autoSize) {
+    if (value.unit == YGUnitPercent) {
+        percent(node, edge, value.value);
+    } else if (value.unit == YGUnitAuto && autoSize) {
+        autoSize(node, edge);
+    } else {
+        points(node, edge, value.unit == YGUnitPoint ? value.value : YGUndefined);
+    }
+}
+
+void setStyleDimension(YGNodeRef node, StyleProp prop, const YGValue& value) {
+    switch (prop) {
+    case StyleWidth:
+        setDimension(node, value, YGNodeStyleSetWidth, YGNodeStyleSetWidthPercent, YGNodeStyleSetWidthAuto);
+        break;
+    case StyleHeight:
+        setDimension(node, value, YGNodeStyleSetHeight, YGNodeStyleSetHeightPercent, YGNodeStyleSetHeightAuto);
+        break;
+    case StyleMinWidth:
+        setDimension(node, value, YGNodeStyleSetMinWidth, YGNodeStyleSetMinWidthPercent, nullptr);
+        break;
+    case StyleMinHeight:
+        setDimension(node, value, YGNodeStyleSetMinHeight, YGNodeStyleSetMinHeightPercent, nullptr);
+        break;
+    case StyleMaxWidth:
+        setDimension(node, value, YGNodeStyleSetMaxWidth, YGNodeStyleSetMaxWidthPercent, nullptr);
+        break;
+    case StyleMaxHeight:
+        setDimension(node, value, YGNodeStyleSetMaxHeight, YGNodeStyleSetMaxHeightPercent, nullptr);
+        break;
+    case StyleFlexBasis:
+        setDimension(
+            node, value, YGNodeStyleSetFlexBasis, YGNodeStyleSetFlexBasisPercent, YGNodeStyleSetFlexBasisAuto);
+        break;
+    case StyleMargin:
+    case StyleMarginTop:
+    case StyleMarginBottom:
+    case StyleMarginLeft:
+    case StyleMarginRight:
+    case StyleMarginHorizontal:
+    case StyleMarginVertical:
+        setEdgeDimension(node,
+                         styleEdge(prop),
+                         value,
+                         YGNodeStyleSetMargin,
+                         YGNodeStyleSetMarginPercent,
+                         YGNodeStyleSetMarginAuto);
+        break;
+    case StylePadding:
+    case StylePaddingTop:
+    case StylePaddingBottom:
+    case StylePaddingLeft:
+    case StylePaddingRight:
+    case StylePaddingHorizontal:
+    case StylePaddingVertical:
+        setEdgeDimension(
+            node, styleEdge(prop), value, YGNodeStyleSetPadding, YGNodeStyleSetPaddingPercent, nullptr);
+        break;
+    case StyleTop:
+    case StyleBottom:
+    case StyleLeft:
+    case StyleRight:
+        setEdgeDimension(
+            node, styleEdge(prop), value, YGNodeStyleSetPosition, YGNodeStyleSetPositionPercent, nullptr);
+        break;
+    default:
+        break;
+    }
+}
+
+void setStyleNumber(YGNodeRef node, StyleProp prop, float value) {
+    switch (prop) {
+    case StyleBorderWidth:
+    case StyleBorderTopWidth:
+    case StyleBorderBottomWidth:
+    case StyleBorderLeftWidth:
+    case StyleBorderRightWidth:
+        YGNodeStyleSetBorder(node, styleEdge(prop), value);
+        break;
+    case StyleFlex:
+        YGNodeStyleSetFlex(node, value);
+        break;
+    case StyleFlexGrow:
+        YGNodeStyleSetFlexGrow(node, value);
+        break;
+    case StyleFlexShrink:
+        YGNodeStyleSetFlexShrink(node, value);
+        break;
+    case StyleAspectRatio:
+        YGNodeStyleSetAspectRatio(node, value);
+        break;
+    default:
+        break;
+    }
+}
+
+void setStyleKeyword(YGNodeRef node, StyleProp prop, int value) {
+    switch (prop) {
+    case StyleFlexDirection:
+        YGNodeStyleSetFlexDirection(node, YGFlexDirection(value));
+        break;
+    case StyleJustifyContent:
+        YGNodeStyleSetJustifyContent(node, YGJustify(value));
+        break;
+    case StyleAlignItems:
+        YGNodeStyleSetAlignItems(node, YGAlign(value));
+        break;
+    case StyleAlignContent:
+        YGNodeStyleSetAlignContent(node, YGAlign(value));
+        break;
+    case StyleAlignSelf:
+        YGNodeStyleSetAlignSelf(node, YGAlign(value));
+        break;
+    case StyleFlexWrap:
+        YGNodeStyleSetFlexWrap(node, YGWrap(value));
+        break;
+    case StyleDisplay:
+        YGNodeStyleSetDisplay(node, YGDisplay(value));
+        break;
+    case StyleOverflow:
+        YGNodeStyleSetOverflow(node, YGOverflow(value));
+        break;
+    case StylePosition:
+        YGNodeStyleSetPositionType(node, YGPositionType(value));
+        break;
+    case StyleDirection:
+        YGNodeStyleSetDirection(node, YGDirection(value));
+        break;
+    default:
+        break;
+    }
+}
+
+// Copy of a live node in the shadow tree of a layout pass. The copies refer to
+// these rather than to the private part of their Flexbox, so the layout thread
+// only reads what was copied when the pass started.
+struct ShadowNode {
+    FlexboxPrivate* d = nullptr;
+    YGNodeRef node = nullptr;
+    // Parent of the live node when it was copied, its layout is stale if it moved since
+    YGNodeRef owner = nullptr;
+    YGNodeRef shadow = nullptr;
+    ygnode_measure_function measureFunction;
+    bool measureThreadSafe = false;
+};
+
+// Pass of Flexbox::recalculateLayoutAsync(), the shadow tree belongs to the layout thread until it's committed
+struct LayoutPass {
+    ~LayoutPass() {
+        if (root) {
+            YGNodeFreeRecursive(root);
+        }
+        for (YGConfigRef config : configs) {
+            YGConfigFree(config);
+        }
+    }
+
+    YGNodeRef root = nullptr;
+    // A deque keeps the shadow nodes where their copies point to while it grows
+    std::deque<ShadowNode> nodes;
+    // Copies of the configs of the copied nodes, bridges may change theirs during the pass
+    QHash<YGConfigRef, YGConfigRef> configs;
+    std::function<void()> committed;
+};
+
+} // namespace
+
 class FlexboxPrivate {
 public:
     FlexboxPrivate() {
@@ -74,15 +474,30 @@ public:
         YGNodeSetContext(m_node, this);
     }
     ~FlexboxPrivate() {
-        YGNodeRef parent = YGNodeGetParent(m_node);
-        if (parent) {
-            YGNodeRemoveChild(parent, m_node);
-        }
+        detach();
         YGNodeFree(m_node);
     }
 
+    static FlexboxPrivate* acquire();
+    static void release(FlexboxPrivate* d);
+
+    void detach();
+    void reset();
+    void freeze();
+    void thaw();
+    // Fixed size leaf of the node's last layout, standing in for it in its parent
+    YGNodeRef createPlaceholder();
+    bool hasLayout() const;
+
+    // onLayout events of a layout pass, grouped by the bridge they are sent through
+    typedef QHash<Bridge*, QVariantList> LayoutEvents;
+
     static void updatePropertiesForControlsTree(YGNodeRef node);
-    static void updatePropertiesForControl(YGNodeRef node);
+    static void updatePropertiesForControl(YGNodeRef node, LayoutEvents& layoutEvents);
+
+    // Copies node and its subtree into the shadow tree of pass, the live nodes become clean
+    static YGNodeRef copyForLayout(YGNodeRef node, LayoutPass* pass);
+    static void commitLayoutPass(FlexboxPrivate* root, LayoutPass* pass);
 
     void printNode();
 
@@ -92,6 +507,13 @@ public:
     QQuickItem* m_control = nullptr;
     ViewManager* m_viewManager = nullptr;
     ygnode_measure_function m_measureFunction = nullptr;
+    bool m_measureThreadSafe = false;
+    // Pass in flight of the tree this node is the root of
+    LayoutPass* m_layoutPass = nullptr;
+    // Copies of the node in the shadow trees of passes in flight, which refer to this private part
+    int m_shadowCopies = 0;
+    // Set when the Flexbox is destroyed while shadow copies of its node remain
+    bool m_released = false;
     QString m_alignItems;
     QString m_alignContent;
     QString m_alignSelf;
@@ -100,30 +522,348 @@ public:
     QString m_overflow;
     QString m_position;
     QString m_direction;
+    bool m_onLayout = false;
+    // Stands in for the node in its parent while it is frozen
+    YGNodeRef m_placeholder = nullptr;
+    // Requested by setFrozen(), the placeholder is only swapped in once the node is attached and laid out
+    bool m_frozen = false;
+    // Keeps the bridge's config alive for as long as the node refers to it
+    std::shared_ptr<YGConfig> m_config;
 };
 
+namespace {
+
+QString* styleKeyword(FlexboxPrivate* d, StyleProp prop) {
+    switch (prop) {
+    case StyleFlexDirection:
+        return &d->m_flexDirection;
+    case StyleJustifyContent:
+        return &d->m_justifyContent;
+    case StyleAlignItems:
+        return &d->m_alignItems;
+    case StyleAlignContent:
+        return &d->m_alignContent;
+    case StyleAlignSelf:
+        return &d->m_alignSelf;
+    case StyleFlexWrap:
+        return &d->m_flexWrap;
+    case StyleDisplay:
+        return &d->m_display;
+    case StyleOverflow:
+        return &d->m_overflow;
+    case StylePosition:
+        return &d->m_position;
+    default:
+        return &d->m_direction;
+    }
+}
+
+const int DEFAULT_NODE_POOL_CAPACITY = 1024;
+
+// Private parts of destroyed Flexbox objects, together with their Yoga
+// nodes, are kept for reuse, so mounting and unmounting long lists doesn't
+// go through the allocator for every node. Only used from the GUI thread.
+struct FlexboxPrivatePool {
+    ~FlexboxPrivatePool() {
+        qDeleteAll(pooled);
+    }
+
+    QVector<FlexboxPrivate*> pooled;
+    int capacity = DEFAULT_NODE_POOL_CAPACITY;
+    int liveCount = 0;
+    int peakCount = 0;
+};
+
+FlexboxPrivatePool& nodePool() {
+    static FlexboxPrivatePool pool;
+    return pool;
+}
+
+} // namespace
+
+FlexboxPrivate* FlexboxPrivate::acquire() {
+    FlexboxPrivatePool& pool = nodePool();
+
+    FlexboxPrivate* d = pool.pooled.isEmpty() ? new FlexboxPrivate() : pool.pooled.takeLast();
+    pool.liveCount++;
+    pool.peakCount = qMax(pool.peakCount, pool.liveCount);
+    return d;
+}
+
+void FlexboxPrivate::release(FlexboxPrivate* d) {
+    FlexboxPrivatePool& pool = nodePool();
+    pool.liveCount--;
+
+    if (pool.pooled.size() >= pool.capacity) {
+        delete d;
+        return;
+    }
+    d->reset();
+    pool.pooled.push_back(d);
+}
+
+void FlexboxPrivate::detach() {
+    if (m_placeholder) {
+        YGNodeFree(m_placeholder);
+        m_placeholder = nullptr;
+    }
+    YGNodeRef parent = YGNodeGetParent(m_node);
+    if (parent) {
+        YGNodeRemoveChild(parent, m_node);
+    }
+}
+
+bool FlexboxPrivate::hasLayout() const {
+    return !YGFloatIsUndefined(YGNodeLayoutGetWidth(m_node)) && !YGFloatIsUndefined(YGNodeLayoutGetHeight(m_node));
+}
+
+YGNodeRef FlexboxPrivate::createPlaceholder() {
+    // Keeps the margins and positioning of the node, but neither grows nor shrinks
+    YGNodeRef placeholder = YGNodeNewWithConfig(m_node->getConfig());
+    placeholder->setStyle(m_node->getStyle());
+    YGNodeStyleSetWidth(placeholder, YGNodeLayoutGetWidth(m_node));
+    YGNodeStyleSetHeight(placeholder, YGNodeLayoutGetHeight(m_node));
+    YGNodeStyleSetMinWidth(placeholder, YGUndefined);
+    YGNodeStyleSetMinHeight(placeholder, YGUndefined);
+    YGNodeStyleSetMaxWidth(placeholder, YGUndefined);
+    YGNodeStyleSetMaxHeight(placeholder, YGUndefined);
+    YGNodeStyleSetFlexGrow(placeholder, 0);
+    YGNodeStyleSetFlexShrink(placeholder, 0);
+    YGNodeStyleSetFlexBasisAuto(placeholder);
+    // Lets updateChildren() find the node a removed placeholder stands in for
+    YGNodeSetContext(placeholder, this);
+    return placeholder;
+}
+
+void FlexboxPrivate::freeze() {
+    m_frozen = true;
+
+    // A detached node is frozen by updateChildren() when it's added, one without a layout after its first pass
+    YGNodeRef parent = m_node->getOwner();
+    if (!parent || m_placeholder || !hasLayout())
+        return;
+
+    m_placeholder = createPlaceholder();
+    parent->cloneChildrenIfNeeded();
+    parent->replaceChild(m_node, m_placeholder);
+    m_placeholder->setOwner(parent);
+    m_node->setOwner(nullptr);
+    parent->markDirtyAndPropogate();
+}
+
+void FlexboxPrivate::thaw() {
+    m_frozen = false;
+    if (!m_placeholder)
+        return;
+
+    YGNodeRef parent = m_placeholder->getOwner();
+    if (parent) {
+        parent->cloneChildrenIfNeeded();
+        parent->replaceChild(m_placeholder, m_node);
+        m_placeholder->setOwner(nullptr);
+        m_node->setOwner(parent);
+        // Changes made while frozen stopped at this node
+        m_node->markDirtyAndPropogate();
+    }
+    YGNodeFree(m_placeholder);
+    m_placeholder = nullptr;
+}
+
+void FlexboxPrivate::reset() {
+    detach();
+    YGNodeRemoveAllChildren(m_node);
+    YGNodeReset(m_node);
+    // Pooled nodes must not refer to the config of a bridge which may be gone
+    m_node->setConfig(YGConfigGetDefault());
+    YGNodeSetContext(m_node, this);
+
+    m_flexDirection.clear();
+    m_justifyContent.clear();
+    m_control = nullptr;
+    m_viewManager = nullptr;
+    m_measureFunction = nullptr;
+    m_measureThreadSafe = false;
+    m_released = false;
+    m_alignItems.clear();
+    m_alignContent.clear();
+    m_alignSelf.clear();
+    m_flexWrap.clear();
+    m_display.clear();
+    m_overflow.clear();
+    m_position.clear();
+    m_direction.clear();
+    m_onLayout = false;
+    m_frozen = false;
+    m_config.reset();
+}
+
 YGSize measure(YGNodeRef node, float width, YGMeasureMode widthMode, float height, YGMeasureMode heightMode) {
     FlexboxPrivate* d = static_cast<FlexboxPrivate*>(YGNodeGetContext(node));
-    auto nodeMeasureFunction = d->m_measureFunction;
-    return nodeMeasureFunction(node, width, widthMode, height, heightMode);
+    return d->m_measureFunction(node, width, widthMode, height, heightMode);
+}
+
+YGSize measureShadow(YGNodeRef shadow, float width, YGMeasureMode widthMode, float height, YGMeasureMode heightMode) {
+    const ShadowNode* shadowNode = static_cast<const ShadowNode*>(YGNodeGetContext(shadow));
+    if (shadowNode->measureThreadSafe) {
+        return shadowNode->measureFunction(shadow, width, widthMode, height, heightMode);
+    }
+
+    return LayoutThread::measureOnGuiThread([=]() {
+        if (shadowNode->d->m_released)
+            return YGSize{0, 0};
+        return shadowNode->measureFunction(shadowNode->node, width, widthMode, height, heightMode);
+    });
+}
+
+YGNodeRef FlexboxPrivate::copyForLayout(YGNodeRef node, LayoutPass* pass) {
+    // The copy keeps the style, the layout caches and the dirty flag of the node
+    YGNodeRef shadow = YGNodeClone(node);
+
+    pass->nodes.push_back(ShadowNode());
+    ShadowNode& shadowNode = pass->nodes.back();
+    shadowNode.d = static_cast<FlexboxPrivate*>(YGNodeGetContext(node));
+    shadowNode.node = node;
+    shadowNode.owner = node->getOwner();
+    shadowNode.shadow = shadow;
+    shadow->setContext(&shadowNode);
+
+    YGConfigRef& config = pass->configs[node->getConfig()];
+    if (!config) {
+        config = YGConfigNew();
+        YGConfigCopy(config, node->getConfig());
+    }
+    shadow->setConfig(config);
+
+    if (shadowNode.d) {
+        ++shadowNode.d->m_shadowCopies;
+        if (node->getMeasure()) {
+            shadowNode.measureFunction = shadowNode.d->m_measureFunction;
+            shadowNode.measureThreadSafe = shadowNode.d->m_measureThreadSafe;
+            shadow->setMeasureFunc(measureShadow);
+        }
+    }
+
+    // Changes made during the pass dirty the live tree again, and the root is laid out once more after the commit
+    node->setDirty(false);
+
+    const uint32_t childCount = YGNodeGetChildCount(node);
+    for (uint32_t i = 0; i < childCount; ++i) {
+        YGNodeRef shadowChild = copyForLayout(node->getChild(i), pass);
+        shadow->replaceChild(shadowChild, i);
+        shadowChild->setOwner(shadow);
+    }
+    return shadow;
+}
+
+void FlexboxPrivate::commitLayoutPass(FlexboxPrivate* root, LayoutPass* pass) {
+    // Nodes removed, moved or destroyed during the pass keep their layout until the next one
+    for (const ShadowNode& shadowNode : pass->nodes) {
+        FlexboxPrivate* d = shadowNode.d;
+        YGNodeRef node = shadowNode.node;
+        if (!d || d->m_released || (node != d->m_node && node != d->m_placeholder) ||
+            node->getOwner() != shadowNode.owner)
+            continue;
+        node->setLayout(shadowNode.shadow->getLayout());
+        node->setHasNewLayout(shadowNode.shadow->getHasNewLayout());
+    }
+
+    root->m_layoutPass = nullptr;
+    if (!root->m_released) {
+        updatePropertiesForControlsTree(root->m_node);
+    }
+
+    // Private parts of the Flexbox objects destroyed during the pass are released with the last copy of their node
+    for (const ShadowNode& shadowNode : pass->nodes) {
+        FlexboxPrivate* d = shadowNode.d;
+        if (d && --d->m_shadowCopies == 0 && d->m_released) {
+            release(d);
+        }
+    }
+
+    const std::function<void()> committed = pass->committed;
+    delete pass;
+    if (committed) {
+        committed();
+    }
 }
 
-Flexbox::Flexbox(QObject* parent) : QObject(parent), d_ptr(new FlexboxPrivate()) {}
+Flexbox::Flexbox(QObject* parent) : QObject(parent), d_ptr(FlexboxPrivate::acquire()) {}
 
-Flexbox::~Flexbox() {}
+Flexbox::~Flexbox() {
+    FlexboxPrivate* d = d_ptr.take();
+    if (d->m_shadowCopies > 0) {
+        // Shadow trees of passes in flight still refer to the private part, it is
+        // released once they're committed. The live tree doesn't need the node anymore.
+        d->m_released = true;
+        d->m_control = nullptr;
+        d->detach();
+        return;
+    }
+    FlexboxPrivate::release(d);
+}
+
+int Flexbox::liveNodeCount() {
+    return nodePool().liveCount;
+}
+
+int Flexbox::peakNodeCount() {
+    return nodePool().peakCount;
+}
+
+int Flexbox::pooledNodeCount() {
+    return nodePool().pooled.size();
+}
+
+void Flexbox::setNodePoolCapacity(int capacity) {
+    FlexboxPrivatePool& pool = nodePool();
+    pool.capacity = qMax(0, capacity);
+    while (pool.pooled.size() > pool.capacity) {
+        delete pool.pooled.takeLast();
+    }
+}
 
 void Flexbox::recalculateLayout(float width, float height) {
+    calculateLayout(width, height);
+    applyLayout();
+}
+
+void Flexbox::calculateLayout(float width, float height) {
     Q_D(Flexbox);
+    // The pass in flight took the dirty flags of the tree along, so layout has to wait for its commit
+    Q_ASSERT(!d->m_layoutPass);
 
     YGNodeCalculateLayout(d->m_node, width, height, YGDirectionLTR);
+}
+
+void Flexbox::applyLayout() {
+    Q_D(Flexbox);
     d->updatePropertiesForControlsTree(d->m_node);
 }
 
-void Flexbox::setMeasureFunction(ygnode_measure_function measureFunction) {
+void Flexbox::recalculateLayoutAsync(float width, float height, const std::function<void()>& committed) {
+    Q_D(Flexbox);
+    Q_ASSERT(!d->m_layoutPass);
+
+    LayoutPass* pass = new LayoutPass();
+    pass->committed = committed;
+    pass->root = FlexboxPrivate::copyForLayout(d->m_node, pass);
+    d->m_layoutPass = pass;
+
+    FlexboxPrivate* root = d;
+    LayoutThread::instance()->calculateLayout(
+        pass->root, width, height, [root, pass]() { FlexboxPrivate::commitLayoutPass(root, pass); });
+}
+
+bool Flexbox::isLayoutInFlight() {
+    return d_ptr->m_layoutPass != nullptr;
+}
+
+void Flexbox::setMeasureFunction(ygnode_measure_function measureFunction, bool threadSafe) {
     Q_D(Flexbox);
 
     d->m_measureFunction = measureFunction;
-    YGNodeSetMeasureFunc(d->m_node, measure);
+    d->m_measureThreadSafe = threadSafe;
+    YGNodeSetMeasureFunc(d->m_node, measureFunction ? measure : nullptr);
 }
 
 void Flexbox::addChild(int index, Flexbox* child) {
@@ -134,19 +874,80 @@ void Flexbox::addChild(int index, Flexbox* child) {
     YGNodeInsertChild(d_ptr->m_node, child->d_ptr->m_node, index);
 }
 
+void Flexbox::removeFromParent() {
+    d_ptr->detach();
+}
+
 void Flexbox::removeChilds(const QList<int>& indicesToRemove) {
-    Q_D(Flexbox);
+    updateChildren(indicesToRemove, QList<int>(), QList<Flexbox*>());
+}
 
-    QList<YGNodeRef> toRemove;
+void Flexbox::updateChildren(const QList<int>& indicesToRemove,
+                             const QList<int>& addAtIndices,
+                             const QList<Flexbox*>& childrenToAdd) {
+    Q_ASSERT(addAtIndices.size() == childrenToAdd.size());
+    if (indicesToRemove.isEmpty() && childrenToAdd.isEmpty())
+        return;
+
+    YGNodeRef node = d_ptr->m_node;
+    node->cloneChildrenIfNeeded();
+
+    const YGVector& oldChildren = node->getChildren();
+    const int oldCount = static_cast<int>(oldChildren.size());
+
+    // Removed children are released first, a moved child is removed and added in the same diff
+    std::vector<bool> removed(oldCount, false);
+    int removedCount = 0;
     for (int index : indicesToRemove) {
-        qCDebug(FLEXBOX) << "::removeChilds YGNode: " << YGNodeGetChild(d->m_node, index)
-                         << " will be removed at index: " << index << " from: " << this;
-        toRemove.push_back(YGNodeGetChild(d->m_node, index));
+        if (index < 0 || index >= oldCount || removed[index]) {
+            qCWarning(FLEXBOX) << "::updateChildren invalid index to remove: " << index << " from: " << this;
+            continue;
+        }
+        removed[index] = true;
+        YGNodeRef removedNode = oldChildren[index];
+        removedNode->setOwner(nullptr);
+        ++removedCount;
+
+        // A frozen child leaves with its placeholder, it is frozen again if it's added back
+        FlexboxPrivate* removedPrivate = static_cast<FlexboxPrivate*>(YGNodeGetContext(removedNode));
+        if (removedPrivate && removedPrivate->m_placeholder == removedNode) {
+            removedPrivate->m_placeholder = nullptr;
+            YGNodeFree(removedNode);
+        }
     }
 
-    for (YGNodeRef nodeToRemove : toRemove) {
-        YGNodeRemoveChild(d->m_node, nodeToRemove);
+    YGVector children;
+    children.reserve(oldCount - removedCount + childrenToAdd.size());
+
+    int addIndex = 0;
+    auto insertAddedChildren = [&](bool remaining) {
+        while (addIndex < childrenToAdd.size() &&
+               (remaining || addAtIndices[addIndex] <= static_cast<int>(children.size()))) {
+            FlexboxPrivate* childPrivate = childrenToAdd[addIndex++]->d_ptr.data();
+            YGNodeRef childNode = childPrivate->m_node;
+            Q_ASSERT(childNode->getOwner() == nullptr);
+            if (childPrivate->m_frozen && !childPrivate->m_placeholder && childPrivate->hasLayout()) {
+                childPrivate->m_placeholder = childPrivate->createPlaceholder();
+                childNode = childPrivate->m_placeholder;
+            }
+            childNode->setOwner(node);
+            children.push_back(childNode);
+        }
+    };
+
+    for (int i = 0; i < oldCount; ++i) {
+        insertAddedChildren(false);
+        if (!removed[i]) {
+            children.push_back(oldChildren[i]);
+        }
     }
+    insertAddedChildren(true);
+
+    qCDebug(FLEXBOX) << "::updateChildren removed: " << removedCount << " added: " << childrenToAdd.size()
+                     << " children count: " << children.size() << " for: " << this;
+
+    node->setChildren(children);
+    node->markDirtyAndPropogate();
 }
 
 Flexbox* Flexbox::findFlexbox(QQuickItem* control) {
@@ -156,19 +957,52 @@ Flexbox* Flexbox::findFlexbox(QQuickItem* control) {
 }
 
 void FlexboxPrivate::updatePropertiesForControlsTree(YGNodeRef node) {
-    static int level = 1;
+    // Yoga only flags the nodes it laid out in the last pass, a subtree whose
+    // cached layout was reused keeps the frames committed before
+    QVarLengthArray<YGNodeRef, 64> nodes;
+    nodes.append(node);
+    LayoutEvents layoutEvents;
+    // Nodes frozen before they had a layout, swapped for placeholders once the walk is done
+    QVector<FlexboxPrivate*> pendingFreezes;
+
+    while (!nodes.isEmpty()) {
+        YGNodeRef current = nodes.takeLast();
+        if (!YGNodeGetHasNewLayout(current))
+            continue;
+        YGNodeSetHasNewLayout(current, false);
+
+        updatePropertiesForControl(current, layoutEvents);
+
+        FlexboxPrivate* d = static_cast<FlexboxPrivate*>(YGNodeGetContext(current));
+        if (d && d->m_node == current && d->m_frozen && !d->m_placeholder) {
+            pendingFreezes.append(d);
+        }
 
-    updatePropertiesForControl(node);
+        const int childCount = YGNodeGetChildCount(current);
+        for (int i = childCount - 1; i >= 0; --i) {
+            nodes.append(YGNodeGetChild(current, i));
+        }
+    }
 
-    int childCount = YGNodeGetChildCount(node);
-    for (int i = 0; i < childCount; ++i) {
-        updatePropertiesForControlsTree(YGNodeGetChild(node, i));
+    for (FlexboxPrivate* d : pendingFreezes) {
+        d->freeze();
+    }
+
+    // Sent only after all frames are committed, so handlers see a consistent tree
+    for (auto it = layoutEvents.constBegin(); it != layoutEvents.constEnd(); ++it) {
+        ViewManager::sendOnLayoutToJs(it.key(), it.value());
     }
 }
 
-void FlexboxPrivate::updatePropertiesForControl(YGNodeRef node) {
-    auto qmlControl = static_cast<FlexboxPrivate*>(YGNodeGetContext(node))->m_control;
-    auto viewManager = static_cast<FlexboxPrivate*>(YGNodeGetContext(node))->m_viewManager;
+void FlexboxPrivate::updatePropertiesForControl(YGNodeRef node, LayoutEvents& layoutEvents) {
+    FlexboxPrivate* d = static_cast<FlexboxPrivate*>(YGNodeGetContext(node));
+    // Placeholders of frozen nodes refer to the Flexbox they stand in for, but have no control of their own
+    if (!d || d->m_node != node)
+        return;
+    auto qmlControl = d->m_control;
+    auto viewManager = d->m_viewManager;
+    if (!qmlControl)
+        return;
 
     bool layoutUpdated = YGNodeLayoutGetLeft(node) != qmlControl->x() || YGNodeLayoutGetTop(node) != qmlControl->y() ||
                          YGNodeLayoutGetWidth(node) != qmlControl->width() ||
@@ -181,14 +1015,14 @@ void FlexboxPrivate::updatePropertiesForControl(YGNodeRef node) {
         qmlControl->setHeight(YGNodeLayoutGetHeight(node));
     }
 
-    if (layoutUpdated) {
+    if (layoutUpdated && d->m_onLayout) {
 
         if (viewManager) {
-            viewManager->sendOnLayoutToJs(qmlControl,
-                                          YGNodeLayoutGetLeft(node),
-                                          YGNodeLayoutGetTop(node),
-                                          YGNodeLayoutGetWidth(node),
-                                          YGNodeLayoutGetHeight(node));
+            layoutEvents[viewManager->bridge()].push_back(ViewManager::layoutEvent(qmlControl,
+                                                                                   YGNodeLayoutGetLeft(node),
+                                                                                   YGNodeLayoutGetTop(node),
+                                                                                   YGNodeLayoutGetWidth(node),
+                                                                                   YGNodeLayoutGetHeight(node)));
 
         } else {
             qCWarning(FLEXBOX) << "::updatePropertiesForControl: "
@@ -213,6 +1047,9 @@ void Flexbox::setViewManager(QObject* value) {
     ViewManager* viewManager = qobject_cast<ViewManager*>(value);
     if (viewManager != d_ptr->m_viewManager) {
         d_ptr->m_viewManager = viewManager;
+        if (viewManager && viewManager->bridge()) {
+            setConfig(viewManager->bridge()->yogaConfig());
+        }
         viewManagerChanged();
     }
 }
@@ -258,7 +1095,7 @@ QString Flexbox::flexDirection() {
 void Flexbox::setFlexDirection(const QString& value) {
     if (value != d_ptr->m_flexDirection) {
         d_ptr->m_flexDirection = value;
-        YGNodeStyleSetFlexDirection(d_ptr->m_node, flexDirectionByString[value]);
+        YGNodeStyleSetFlexDirection(d_ptr->m_node, flexDirectionByString.value(value));
         flexDirectionChanged();
     }
 }
@@ -270,7 +1107,7 @@ QString Flexbox::justifyContent() {
 void Flexbox::setJustifyContent(const QString& value) {
     if (value != d_ptr->m_justifyContent) {
         d_ptr->m_justifyContent = value;
-        YGNodeStyleSetJustifyContent(d_ptr->m_node, justificationByString[value]);
+        YGNodeStyleSetJustifyContent(d_ptr->m_node, justificationByString.value(value));
         justifyContentChanged();
     }
 }
@@ -442,7 +1279,7 @@ QString Flexbox::alignItems() {
 void Flexbox::setAlignItems(const QString& value) {
     if (value != d_ptr->m_alignItems) {
         d_ptr->m_alignItems = value;
-        YGNodeStyleSetAlignItems(d_ptr->m_node, alignByString[value]);
+        YGNodeStyleSetAlignItems(d_ptr->m_node, alignByString.value(value));
         alignItemsChanged();
     }
 }
@@ -454,7 +1291,7 @@ QString Flexbox::alignContent() {
 void Flexbox::setAlignContent(const QString& value) {
     if (value != d_ptr->m_alignContent) {
         d_ptr->m_alignContent = value;
-        YGNodeStyleSetAlignContent(d_ptr->m_node, alignByString[value]);
+        YGNodeStyleSetAlignContent(d_ptr->m_node, alignByString.value(value));
         alignContentChanged();
     }
 }
@@ -466,7 +1303,7 @@ QString Flexbox::alignSelf() {
 void Flexbox::setAlignSelf(const QString& value) {
     if (value != d_ptr->m_alignSelf) {
         d_ptr->m_alignSelf = value;
-        YGNodeStyleSetAlignSelf(d_ptr->m_node, alignByString[value]);
+        YGNodeStyleSetAlignSelf(d_ptr->m_node, alignByString.value(value));
         alignSelfChanged();
     }
 }
@@ -653,7 +1490,7 @@ QString Flexbox::flexWrap() {
 void Flexbox::setFlexWrap(const QString& value) {
     if (value != d_ptr->m_flexWrap) {
         d_ptr->m_flexWrap = value;
-        YGNodeStyleSetFlexWrap(d_ptr->m_node, wrapByString[value]);
+        YGNodeStyleSetFlexWrap(d_ptr->m_node, wrapByString.value(value));
         flexWrapChanged();
     }
 }
@@ -770,7 +1607,7 @@ QString Flexbox::display() {
 void Flexbox::setDisplay(const QString& value) {
     if (value != d_ptr->m_display) {
         d_ptr->m_display = value;
-        YGNodeStyleSetDisplay(d_ptr->m_node, displayByString[value]);
+        YGNodeStyleSetDisplay(d_ptr->m_node, displayByString.value(value));
         displayChanged();
     }
 }
@@ -782,7 +1619,7 @@ QString Flexbox::overflow() {
 void Flexbox::setOverflow(const QString& value) {
     if (value != d_ptr->m_overflow) {
         d_ptr->m_overflow = value;
-        YGNodeStyleSetOverflow(d_ptr->m_node, overflowByString[value]);
+        YGNodeStyleSetOverflow(d_ptr->m_node, overflowByString.value(value));
         overflowChanged();
     }
 }
@@ -794,7 +1631,7 @@ QString Flexbox::position() {
 void Flexbox::setPosition(const QString& value) {
     if (value != d_ptr->m_position) {
         d_ptr->m_position = value;
-        YGNodeStyleSetPositionType(d_ptr->m_node, positionByString[value]);
+        YGNodeStyleSetPositionType(d_ptr->m_node, positionByString.value(value));
         positionChanged();
     }
 }
@@ -806,31 +1643,94 @@ QString Flexbox::direction() {
 void Flexbox::setDirection(const QString& value) {
     if (value != d_ptr->m_direction) {
         d_ptr->m_direction = value;
-        YGNodeStyleSetDirection(d_ptr->m_node, directionByString[value]);
+        YGNodeStyleSetDirection(d_ptr->m_node, directionByString.value(value));
         directionChanged();
     }
 }
 
+bool Flexbox::onLayout() {
+    return d_ptr->m_onLayout;
+}
+
+void Flexbox::setOnLayout(bool value) {
+    if (value != d_ptr->m_onLayout) {
+        d_ptr->m_onLayout = value;
+        onLayoutChanged();
+    }
+}
+
+bool Flexbox::applyStyle(const QString& name, const QVariant& value) {
+    const QHash<QString, StyleProp>& props = stylePropsByName();
+    auto it = props.constFind(name);
+    if (it == props.constEnd())
+        return false;
+
+    const StyleProp prop = *it;
+    if (prop < StyleBorderWidth) {
+        setStyleDimension(d_ptr->m_node, prop, decodeDimension(value));
+    } else if (prop < StyleFlexDirection) {
+        setStyleNumber(d_ptr->m_node, prop, value.isNull() ? YGUndefined : value.toFloat());
+    } else if (prop < StyleOnLayout) {
+        // Keywords are kept for the getters, which return them as js set them
+        const QString keyword = value.toString();
+        *styleKeyword(d_ptr.data(), prop) = keyword;
+        setStyleKeyword(d_ptr->m_node, prop, decodeKeyword(prop, keyword));
+    } else {
+        d_ptr->m_onLayout = value.toBool();
+    }
+    return true;
+}
+
 bool Flexbox::isDirty() {
     return YGNodeIsDirty(d_ptr->m_node);
 }
 
 bool Flexbox::parsePercents(QVariant& value, float& result) {
-    if (value.type() == QMetaType::QString) {
-        QString valueString = value.toString();
-        if (valueString.back() == '%') {
-            valueString.chop(1);
-            bool success = false;
-            result = valueString.toFloat(&success);
-            if (success) {
-                return true;
-            }
-        }
-        qCDebug(FLEXBOX) << "Unable to parse value " << valueString;
+    // Numbers, by far the most common values, are never percents
+    if (value.type() != QMetaType::QString)
+        return false;
+
+    QString valueString = value.toString();
+    bool success = false;
+    if (valueString.endsWith('%')) {
+        valueString.chop(1);
+        result = valueString.toFloat(&success);
+        if (success)
+            return true;
+    } else {
+        // Points, converted by the caller
+        valueString.toFloat(&success);
+        if (success || valueString == "auto")
+            return false;
     }
+    qCDebug(FLEXBOX) << "Unable to parse value " << value.toString();
     return false;
 }
 
+void Flexbox::setConfig(const std::shared_ptr<YGConfig>& config) {
+    Q_D(Flexbox);
+    if (d->m_config == config)
+        return;
+
+    d->m_config = config;
+    d->m_node->setConfig(config.get());
+    // Yoga applies the web style defaults to nodes created with the config, while this one was
+    // created with the default config
+    if (YGConfigGetUseWebDefaults(config.get())) {
+        if (d->m_flexDirection.isEmpty()) {
+            YGNodeStyleSetFlexDirection(d->m_node, YGFlexDirectionRow);
+        }
+        if (d->m_alignContent.isEmpty()) {
+            YGNodeStyleSetAlignContent(d->m_node, YGAlignStretch);
+        }
+    }
+    d->m_node->markDirtyAndPropogate();
+}
+
+void Flexbox::markSubtreeDirty() {
+    d_ptr->m_node->markDirtyAndPropogateDownwards();
+}
+
 void Flexbox::markDirty() {
     if (d_ptr->m_node) {
         YGNodeMarkDirty(d_ptr->m_node);
@@ -841,6 +1741,14 @@ bool Flexbox::isUndefined(float value) {
     return YGFloatIsUndefined(value);
 }
 
+void Flexbox::setFrozen(bool frozen) {
+    if (frozen) {
+        d_ptr->freeze();
+    } else {
+        d_ptr->thaw();
+    }
+}
+
 void Flexbox::printFlexboxHierarchy() {
     d_ptr->printNode();
 }
@@ -861,7 +1769,11 @@ void FlexboxPrivate::printNode() {
     for (int i = 0; i < YGNodeGetChildCount(m_node); ++i) {
         YGNodeRef childNode = YGNodeGetChild(m_node, i);
         FlexboxPrivate* fp = static_cast<FlexboxPrivate*>(YGNodeGetContext(childNode));
-        fp->printNode();
+        if (fp && fp->m_node == childNode) {
+            fp->printNode();
+        } else {
+            printYGNode(childNode, "frozen");
+        }
     }
     --level;
 }
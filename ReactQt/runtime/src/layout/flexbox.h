@@ -15,6 +15,7 @@
 #include <QLoggingCategory>
 #include <QObject>
 #include <functional>
+#include <memory>
 
 Q_DECLARE_LOGGING_CATEGORY(FLEXBOX)
 
@@ -80,6 +81,7 @@ class Flexbox : public QObject {
     Q_PROPERTY(QString p_overflow READ overflow WRITE setOverflow NOTIFY overflowChanged)
     Q_PROPERTY(QString p_position READ position WRITE setPosition NOTIFY positionChanged)
     Q_PROPERTY(QString p_direction READ direction WRITE setDirection NOTIFY directionChanged)
+    Q_PROPERTY(bool p_onLayout READ onLayout WRITE setOnLayout NOTIFY onLayoutChanged)
     Q_PROPERTY(bool isDirty READ isDirty NOTIFY isDirtyChanged)
 
 signals:
@@ -129,6 +131,7 @@ signals:
     void overflowChanged();
     void positionChanged();
     void directionChanged();
+    void onLayoutChanged();
     void isDirtyChanged();
     //    void recalculated();
 
@@ -137,13 +140,53 @@ public:
     ~Flexbox();
 
     void recalculateLayout(float width, float height);
-    void setMeasureFunction(ygnode_measure_function measureFunction);
+    // The two phases of recalculateLayout: Yoga's calculation and committing
+    // the frames of the nodes with new layout to their items
+    void calculateLayout(float width, float height);
+    void applyLayout();
+    // Calculates the layout of a copy of the tree on the layout thread and commits it to the
+    // items afterwards, then calls committed. The tree may change meanwhile, it is dirty after
+    // the commit if it did.
+    void recalculateLayoutAsync(float width,
+                                float height,
+                                const std::function<void()>& committed = std::function<void()>());
+    // True while the pass of recalculateLayoutAsync() waits to be committed
+    bool isLayoutInFlight();
+    // Measure functions which aren't thread safe are called on the GUI thread
+    void setMeasureFunction(ygnode_measure_function measureFunction, bool threadSafe = false);
     void addChild(int index, Flexbox* child);
     void removeChilds(const QList<int>& indicesToRemove);
+    // Detaches the node from whichever node it is a child of
+    void removeFromParent();
+    // Applies a whole manageChildren diff to the child list in one pass, marking the node dirty once.
+    // indicesToRemove refer to the current children, addAtIndices are ascending indices into the result.
+    void updateChildren(const QList<int>& indicesToRemove,
+                        const QList<int>& addAtIndices,
+                        const QList<Flexbox*>& childrenToAdd);
     void printFlexboxHierarchy();
+    // A frozen node is left out of layout passes: its parent lays out a fixed size leaf of the node's
+    // last size in its place, and changes within the subtree aren't laid out until it is thawed.
+    void setFrozen(bool frozen);
+
+    void setConfig(const std::shared_ptr<YGConfig>& config);
+    // Makes the next pass lay out every node of the subtree again, e.g. after a config change
+    void markSubtreeDirty();
 
     static Flexbox* findFlexbox(QQuickItem* control);
 
+    // Applies a style prop as received from js, a null value restores the default.
+    // Goes straight to the Yoga node, so unlike the p_ setters it emits no change signals.
+    // Returns false for props which aren't Flexbox styles.
+    bool applyStyle(const QString& name, const QVariant& value);
+
+    // Yoga nodes are recycled through a pool when their Flexbox is destroyed.
+    // Counts are of nodes in use by Flexbox objects, the most of them in use
+    // at once, and nodes kept in the pool for reuse.
+    static int liveNodeCount();
+    static int peakNodeCount();
+    static int pooledNodeCount();
+    static void setNodePoolCapacity(int capacity);
+
     QQuickItem* control();
     void setControl(QQuickItem* value);
     QObject* viewManager();
@@ -236,6 +279,9 @@ public:
     void setPosition(const QString& value);
     QString direction();
     void setDirection(const QString& value);
+    // True when JS registered an onLayout handler for the view
+    bool onLayout();
+    void setOnLayout(bool value);
     bool isDirty();
 
 private:
@@ -0,0 +1,99 @@
+
+/**
+ * Copyright (c) 2017-present, Status Research and Development GmbH.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "layoutthread.h"
+
+#include <QCoreApplication>
+#include <QThread>
+
+namespace {
+LayoutThread* layoutThreadInstance = nullptr;
+}
+
+class LayoutThreadPrivate {
+public:
+    QThread thread;
+    QObject* worker = nullptr;
+    int passesInFlight = 0;
+};
+
+LayoutThread::LayoutThread(QObject* parent) : QObject(parent), d_ptr(new LayoutThreadPrivate) {
+    Q_D(LayoutThread);
+
+    d->thread.setObjectName("ReactLayoutThread");
+    d->worker = new QObject();
+    d->worker->moveToThread(&d->thread);
+    connect(&d->thread, &QThread::finished, d->worker, &QObject::deleteLater);
+    d->thread.start();
+
+    connect(qApp, &QCoreApplication::aboutToQuit, this, &LayoutThread::shutdown);
+}
+
+LayoutThread::~LayoutThread() {
+    shutdown();
+    layoutThreadInstance = nullptr;
+}
+
+LayoutThread* LayoutThread::instance() {
+    Q_ASSERT(QThread::currentThread() == qApp->thread());
+    if (layoutThreadInstance == nullptr) {
+        layoutThreadInstance = new LayoutThread(qApp);
+    }
+    return layoutThreadInstance;
+}
+
+void LayoutThread::calculateLayout(YGNodeRef root,
+                                   float width,
+                                   float height,
+                                   const std::function<void()>& commit) {
+    Q_D(LayoutThread);
+
+    ++d->passesInFlight;
+    QMetaObject::invokeMethod(d->worker,
+                              [=]() {
+                                  YGNodeCalculateLayout(root, width, height, YGDirectionLTR);
+                                  QMetaObject::invokeMethod(
+                                      this, [=]() { finishLayout(commit); }, Qt::QueuedConnection);
+                              },
+                              Qt::QueuedConnection);
+}
+
+YGSize LayoutThread::measureOnGuiThread(const std::function<YGSize()>& measure) {
+    if (QThread::currentThread() == qApp->thread())
+        return measure();
+
+    // The GUI thread never waits for the layout thread while passes are in flight,
+    // except for shutdown(), which keeps processing events until they're committed
+    YGSize size{0, 0};
+    QMetaObject::invokeMethod(
+        layoutThreadInstance, [&]() { size = measure(); }, Qt::BlockingQueuedConnection);
+    return size;
+}
+
+void LayoutThread::finishLayout(const std::function<void()>& commit) {
+    Q_D(LayoutThread);
+
+    --d->passesInFlight;
+    commit();
+}
+
+void LayoutThread::shutdown() {
+    Q_D(LayoutThread);
+
+    if (!d->thread.isRunning())
+        return;
+
+    while (d->passesInFlight > 0) {
+        QCoreApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
+    }
+    d->thread.quit();
+    d->thread.wait();
+}
@@ -0,0 +1,53 @@
+
+/**
+ * Copyright (c) 2017-present, Status Research and Development GmbH.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#ifndef LAYOUTTHREAD_H
+#define LAYOUTTHREAD_H
+
+#include <QObject>
+#include <QScopedPointer>
+
+#include <functional>
+
+#include "../../../ReactCommon/yoga/yoga/Yoga.h"
+
+// Calculates Yoga layout on a dedicated thread.
+//
+// Passes run on shadow copies of the Yoga trees (see Flexbox::recalculateLayoutAsync()),
+// which belong to the layout thread until their pass is committed. The GUI thread keeps
+// mutating the live trees in the meantime, and passes of different root views don't
+// wait for each other.
+class LayoutThreadPrivate;
+class LayoutThread : public QObject {
+    Q_OBJECT
+    Q_DECLARE_PRIVATE(LayoutThread)
+
+public:
+    ~LayoutThread();
+
+    static LayoutThread* instance();
+
+    // Lays out the shadow tree rooted at root on the layout thread, then calls commit on the GUI thread
+    void calculateLayout(YGNodeRef root, float width, float height, const std::function<void()>& commit);
+
+    // Measure functions of QML based views have to run in the thread their items live in
+    static YGSize measureOnGuiThread(const std::function<YGSize()>& measure);
+
+private:
+    LayoutThread(QObject* parent = nullptr);
+
+    void finishLayout(const std::function<void()>& commit);
+    void shutdown();
+
+    QScopedPointer<LayoutThreadPrivate> d_ptr;
+};
+
+#endif // LAYOUTTHREAD_H
@@ -0,0 +1,135 @@
+
+/**
+ * Copyright (c) 2017-present, Status Research and Development GmbH.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "textmeasurer.h"
+
+#include <QCache>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSizeF>
+#include <QTextDocument>
+#include <QTextOption>
+
+#include <cmath>
+
+namespace {
+
+const int DEFAULT_CACHE_CAPACITY = 2000;
+
+struct MeasureKey {
+    // Implicitly shared, keys only hold a reference to the text. Its hash is cached by the text.
+    AttributedText text;
+    QString fontKey;
+    float width;
+    YGMeasureMode widthMode;
+
+    bool operator==(const MeasureKey& other) const {
+        return width == other.width && widthMode == other.widthMode && fontKey == other.fontKey &&
+               text == other.text;
+    }
+};
+
+uint qHash(const MeasureKey& key, uint seed = 0) {
+    return ::qHash(key.text.hash(), seed) ^ ::qHash(key.fontKey, seed) ^ ::qHash(key.width, seed) ^
+           ::qHash(int(key.widthMode), seed);
+}
+
+struct MeasureCache {
+    QMutex mutex;
+    // Content size of the text for a width constraint, height constraints are applied on top of it
+    QCache<MeasureKey, QSizeF> sizes{DEFAULT_CACHE_CAPACITY};
+};
+
+MeasureCache& measureCache() {
+    static MeasureCache cache;
+    return cache;
+}
+
+QSizeF layoutText(const AttributedText& text, const QFont& font, float width, bool widthConstrained) {
+    // Matches ReactText: Text.Wrap and no document margin
+    QTextDocument document;
+    document.setDocumentMargin(0);
+    document.setDefaultFont(font);
+    QTextOption option = document.defaultTextOption();
+    option.setWrapMode(QTextOption::WrapAtWordBoundaryOrAnywhere);
+    document.setDefaultTextOption(option);
+    text.applyTo(&document);
+    document.setTextWidth(widthConstrained ? width : -1);
+
+    return QSizeF(document.idealWidth(), document.size().height());
+}
+
+float constrain(float contentSize, float size, YGMeasureMode mode) {
+    switch (mode) {
+    case YGMeasureModeExactly:
+        return size;
+    case YGMeasureModeAtMost:
+        return qMin(contentSize, size);
+    default:
+        return contentSize;
+    }
+}
+
+} // namespace
+
+YGSize TextMeasurer::measure(const AttributedText& text,
+                             const QFont& font,
+                             float width,
+                             YGMeasureMode widthMode,
+                             float height,
+                             YGMeasureMode heightMode) {
+    const bool widthConstrained = widthMode != YGMeasureModeUndefined && !std::isnan(width);
+    const MeasureKey key{text,
+                         font.key(),
+                         widthConstrained ? width : 0,
+                         widthConstrained ? widthMode : YGMeasureModeUndefined};
+
+    MeasureCache& cache = measureCache();
+    QSizeF contentSize;
+    bool cached = false;
+    {
+        QMutexLocker locker(&cache.mutex);
+        if (QSizeF* size = cache.sizes.object(key)) {
+            contentSize = *size;
+            cached = true;
+        }
+    }
+
+    if (!cached) {
+        // Laid out outside of the lock, texts measured concurrently don't wait for each other
+        contentSize = layoutText(text, font, width, widthConstrained);
+        QMutexLocker locker(&cache.mutex);
+        cache.sizes.insert(key, new QSizeF(contentSize));
+    }
+
+    const YGMeasureMode heightConstraint = std::isnan(height) ? YGMeasureModeUndefined : heightMode;
+    return YGSize{constrain(std::ceil(contentSize.width()), width, key.widthMode),
+                  constrain(std::ceil(contentSize.height()), height, heightConstraint)};
+}
+
+int TextMeasurer::cacheCapacity() {
+    MeasureCache& cache = measureCache();
+    QMutexLocker locker(&cache.mutex);
+    return cache.sizes.maxCost();
+}
+
+void TextMeasurer::setCacheCapacity(int capacity) {
+    MeasureCache& cache = measureCache();
+    QMutexLocker locker(&cache.mutex);
+    cache.sizes.setMaxCost(capacity);
+}
+
+void TextMeasurer::clearCache() {
+    MeasureCache& cache = measureCache();
+    QMutexLocker locker(&cache.mutex);
+    cache.sizes.clear();
+}
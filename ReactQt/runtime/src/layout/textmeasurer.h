@@ -0,0 +1,41 @@
+
+/**
+ * Copyright (c) 2017-present, Status Research and Development GmbH.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#ifndef TEXTMEASURER_H
+#define TEXTMEASURER_H
+
+#include <QFont>
+
+#include "../../../ReactCommon/yoga/yoga/Yoga.h"
+#include "attributedtext.h"
+
+// Measures text the way ReactText lays it out, without touching the item.
+//
+// Text is laid out in an offscreen QTextDocument and the resulting sizes are
+// kept in an LRU cache keyed by text, font and width constraint, as Yoga tends
+// to measure the same node several times per pass. Safe to call from the
+// layout thread.
+class TextMeasurer {
+public:
+    static YGSize measure(const AttributedText& text,
+                          const QFont& font,
+                          float width,
+                          YGMeasureMode widthMode,
+                          float height,
+                          YGMeasureMode heightMode);
+
+    // Number of measurements kept in the cache
+    static int cacheCapacity();
+    static void setCacheCapacity(int capacity);
+    static void clearCache();
+};
+
+#endif // TEXTMEASURER_H
@@ -127,6 +127,14 @@ ModuleMethod* ModuleData::method(int id) const {
     return d_func()->methods.value(id);
 }
 
+int ModuleData::methodCount() const {
+    return d_func()->methods.size();
+}
+
+QVariantMap ModuleData::constants() const {
+    return d_func()->constants;
+}
+
 ViewManager* ModuleData::viewManager() const {
     return qobject_cast<ModuleInterface*>(d_func()->moduleImpl)->viewManager();
 }
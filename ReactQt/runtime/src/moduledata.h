@@ -15,6 +15,7 @@
 #define MODULEDATA_H
 
 #include <QScopedPointer>
+#include <QVariantMap>
 
 class QObject;
 class ModuleMethod;
@@ -35,6 +36,9 @@ public:
     QVariant info() const;
 
     ModuleMethod* method(int id) const;
+    int methodCount() const;
+
+    QVariantMap constants() const;
 
     ViewManager* viewManager() const;
 
@@ -37,6 +37,14 @@ NativeMethodType ModuleMethod::type() const {
     return NativeMethodType::Async;
 }
 
+int ModuleMethod::parameterCount() const {
+    return m_metaMethod.parameterCount();
+}
+
+int ModuleMethod::parameterType(int index) const {
+    return m_metaMethod.parameterType(index);
+}
+
 // meh
 #define _R_ARG(argn) QGenericArgument(argn.typeName(), argn.data())
 
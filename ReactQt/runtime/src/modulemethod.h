@@ -33,6 +33,8 @@ public:
 
     QString name() const;
     NativeMethodType type() const;
+    int parameterCount() const;
+    int parameterType(int index) const;
 
     Q_INVOKABLE void invoke(const QVariantList& args);
 
@@ -0,0 +1,843 @@
+
+/**
+ * Copyright (c) 2017-present, Status Research and Development GmbH.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include <QElapsedTimer>
+#include <QMatrix4x4>
+#include <QPointer>
+#include <QQuickItem>
+#include <QQuickWindow>
+#include <QTimer>
+#include <QtMath>
+
+#include <cmath>
+
+#include "attachedproperties.h"
+#include "bridge.h"
+#include "eventdispatcher.h"
+#include "interpolation.h"
+#include "layout/flexbox.h"
+#include "nativeanimatedmodule.h"
+#include "rootview.h"
+#include "uimanager.h"
+#include "utilities.h"
+
+Q_LOGGING_CATEGORY(NATIVEANIMATED, "NativeAnimatedModule")
+
+namespace {
+// Frames of timing animations are sampled by js at 60 fps
+const double FRAME_DURATION = 1000.0 / 60;
+// Used when the root view isn't shown in a window yet
+const int FALLBACK_FRAME_INTERVAL = 16;
+
+struct AnimatedNode {
+    enum Type {
+        ValueNode,
+        StyleNode,
+        PropsNode,
+        InterpolationNode,
+        AdditionNode,
+        SubtractionNode,
+        MultiplicationNode,
+        DivisionNode,
+        ModulusNode,
+        DiffClampNode,
+        TransformNode
+    };
+
+    Type type = ValueNode;
+    QVariantMap config;
+    QList<int> parents;
+    QList<int> children;
+
+    // Output of value, interpolation and math nodes
+    double value = 0;
+    double offset = 0;
+    // Output of style and transform nodes
+    QVariant output;
+
+    Interpolation interpolation;
+    double lastInputValue = 0;
+    int viewTag = -1;
+    QSet<QString> appliedProps;
+};
+
+struct AnimationDriver {
+    int nodeTag = -1;
+    QString type;
+    QVariantMap config;
+    ModuleInterface::ListArgumentBlock endCallback;
+
+    qint64 startTime = -1;
+    double fromValue = 0;
+    double lastValue = 0;
+    int iterations = 1;
+    int currentIteration = 1;
+};
+
+const QHash<QString, AnimatedNode::Type>& nodeTypes() {
+    static const QHash<QString, AnimatedNode::Type> types{{"value", AnimatedNode::ValueNode},
+                                                          {"style", AnimatedNode::StyleNode},
+                                                          {"props", AnimatedNode::PropsNode},
+                                                          {"interpolation", AnimatedNode::InterpolationNode},
+                                                          {"addition", AnimatedNode::AdditionNode},
+                                                          {"subtraction", AnimatedNode::SubtractionNode},
+                                                          {"multiplication", AnimatedNode::MultiplicationNode},
+                                                          {"division", AnimatedNode::DivisionNode},
+                                                          {"modulus", AnimatedNode::ModulusNode},
+                                                          {"diffclamp", AnimatedNode::DiffClampNode},
+                                                          {"transform", AnimatedNode::TransformNode}};
+    return types;
+}
+
+QVariantList matrixToList(const QMatrix4x4& matrix) {
+    // Column major, as ReactItem's transform prop
+    QVariantList list;
+    list.reserve(16);
+    const float* data = matrix.constData();
+    for (int i = 0; i < 16; ++i) {
+        list.push_back(data[i]);
+    }
+    return list;
+}
+} // namespace
+
+class NativeAnimatedModulePrivate {
+    Q_DECLARE_PUBLIC(NativeAnimatedModule)
+
+public:
+    NativeAnimatedModulePrivate(NativeAnimatedModule* q) : q_ptr(q) {}
+
+    AnimatedNode* node(int tag, const char* caller);
+    double nodeValue(int tag) const;
+    void updateNode(int tag, AnimatedNode& node);
+    void updateNodes(const QSet<int>& updatedTags);
+    void applyProps(AnimatedNode& node, const QVariantMap& props);
+    QVariantMap propsOf(const AnimatedNode& node) const;
+    QMatrix4x4 transformOf(const AnimatedNode& node) const;
+
+    bool stepDriver(AnimationDriver& driver, AnimatedNode& node, qint64 now);
+    bool stepFrames(AnimationDriver& driver, AnimatedNode& node, double elapsed);
+    bool stepSpring(AnimationDriver& driver, AnimatedNode& node, double elapsed);
+    bool stepDecay(AnimationDriver& driver, AnimatedNode& node, double elapsed);
+    bool nextIteration(AnimationDriver& driver, AnimatedNode& node);
+    void finishDriver(const AnimationDriver& driver, bool finished);
+    void stopAnimationsOfNode(int nodeTag);
+
+    void scheduleFrame();
+    void stopFrames();
+
+    QPointer<Bridge> bridge;
+    QHash<int, AnimatedNode> nodes;
+    QMap<int, AnimationDriver> drivers;
+    QSet<int> listenedTags;
+
+    struct EventMapping {
+        QStringList nativeEventPath;
+        int nodeTag;
+    };
+    QHash<QPair<int, QString>, QList<EventMapping>> eventMappings;
+
+    QElapsedTimer frameClock;
+    QPointer<QQuickWindow> frameWindow;
+    QTimer fallbackTimer;
+    // Views with layout props animated since the last layout pass
+    bool layoutRequested = false;
+
+    NativeAnimatedModule* q_ptr;
+};
+
+AnimatedNode* NativeAnimatedModulePrivate::node(int tag, const char* caller) {
+    auto it = nodes.find(tag);
+    if (it == nodes.end()) {
+        qCWarning(NATIVEANIMATED) << caller << "called for unknown animated node; tag=" << tag;
+        return nullptr;
+    }
+    return &it.value();
+}
+
+double NativeAnimatedModulePrivate::nodeValue(int tag) const {
+    auto it = nodes.constFind(tag);
+    return it != nodes.constEnd() ? it->value + it->offset : 0;
+}
+
+void NativeAnimatedModulePrivate::updateNode(int tag, AnimatedNode& node) {
+    auto inputValues = [&]() {
+        QList<double> values;
+        for (const QVariant& input : node.config.value("input").toList()) {
+            values.push_back(nodeValue(input.toInt()));
+        }
+        return values;
+    };
+
+    switch (node.type) {
+    case AnimatedNode::ValueNode:
+        if (listenedTags.contains(tag) && bridge) {
+            // Offset is kept by js, as with values set from js
+            bridge->eventDispatcher()->sendDeviceEvent("onAnimatedValueUpdate",
+                                                       QVariantMap{{"tag", tag}, {"value", node.value}});
+        }
+        break;
+    case AnimatedNode::InterpolationNode:
+        if (!node.parents.isEmpty()) {
+            node.value = node.interpolation.evaluate(nodeValue(node.parents.first()));
+        }
+        break;
+    case AnimatedNode::AdditionNode:
+    case AnimatedNode::SubtractionNode:
+    case AnimatedNode::MultiplicationNode:
+    case AnimatedNode::DivisionNode: {
+        const QList<double> values = inputValues();
+        if (values.isEmpty())
+            break;
+        double result = values.first();
+        for (int i = 1; i < values.size(); ++i) {
+            if (node.type == AnimatedNode::AdditionNode) {
+                result += values[i];
+            } else if (node.type == AnimatedNode::SubtractionNode) {
+                result -= values[i];
+            } else if (node.type == AnimatedNode::MultiplicationNode) {
+                result *= values[i];
+            } else if (values[i] != 0) {
+                result /= values[i];
+            } else {
+                qCWarning(NATIVEANIMATED) << "Detected a division by zero in animated node; tag=" << tag;
+            }
+        }
+        node.value = result;
+        break;
+    }
+    case AnimatedNode::ModulusNode: {
+        const double modulus = node.config.value("modulus").toDouble();
+        if (modulus != 0) {
+            const double input = nodeValue(node.config.value("input").toInt());
+            node.value = std::fmod(std::fmod(input, modulus) + modulus, modulus);
+        }
+        break;
+    }
+    case AnimatedNode::DiffClampNode: {
+        const double input = nodeValue(node.config.value("input").toInt());
+        const double diff = input - node.lastInputValue;
+        node.lastInputValue = input;
+        node.value =
+            qBound(node.config.value("min").toDouble(), node.value + diff, node.config.value("max").toDouble());
+        break;
+    }
+    case AnimatedNode::TransformNode:
+        node.output = matrixToList(transformOf(node));
+        break;
+    case AnimatedNode::StyleNode:
+        node.output = propsOf(node);
+        break;
+    case AnimatedNode::PropsNode:
+        applyProps(node, propsOf(node));
+        break;
+    }
+}
+
+void NativeAnimatedModulePrivate::updateNodes(const QSet<int>& updatedTags) {
+    // Nodes depending on several updated ones are updated once, after all of them
+    QHash<int, int> activeIncomingNodes;
+    QSet<int> visited;
+    QList<int> queue;
+    for (int tag : updatedTags) {
+        if (nodes.contains(tag) && !visited.contains(tag)) {
+            visited.insert(tag);
+            queue.push_back(tag);
+        }
+    }
+    for (int i = 0; i < queue.size(); ++i) {
+        for (int child : nodes.value(queue[i]).children) {
+            ++activeIncomingNodes[child];
+            if (!visited.contains(child)) {
+                visited.insert(child);
+                queue.push_back(child);
+            }
+        }
+    }
+
+    queue.clear();
+    for (int tag : updatedTags) {
+        if (nodes.contains(tag) && activeIncomingNodes.value(tag) == 0) {
+            queue.push_back(tag);
+        }
+    }
+    for (int i = 0; i < queue.size(); ++i) {
+        AnimatedNode& node = nodes[queue[i]];
+        updateNode(queue[i], node);
+        for (int child : node.children) {
+            if (--activeIncomingNodes[child] == 0) {
+                queue.push_back(child);
+            }
+        }
+    }
+
+    if (queue.size() < visited.size()) {
+        qCWarning(NATIVEANIMATED) << "Detected a cycle in the animated node graph, some nodes were not updated";
+    }
+
+    if (layoutRequested) {
+        layoutRequested = false;
+        if (bridge && bridge->visualParent()) {
+            bridge->visualParent()->recalculateLayout();
+        }
+    }
+}
+
+QVariantMap NativeAnimatedModulePrivate::propsOf(const AnimatedNode& node) const {
+    const QVariantMap tags = node.config.value(node.type == AnimatedNode::StyleNode ? "style" : "props").toMap();
+
+    QVariantMap props;
+    for (auto it = tags.constBegin(); it != tags.constEnd(); ++it) {
+        auto input = nodes.constFind(it.value().toInt());
+        if (input == nodes.constEnd())
+            continue;
+
+        // Styles are flattened into the props, as they are for views updated by the UIManager
+        if (input->type == AnimatedNode::StyleNode) {
+            props.unite(input->output.toMap());
+        } else if (input->type == AnimatedNode::TransformNode) {
+            props.insert(it.key(), input->output);
+        } else {
+            props.insert(it.key(), input->value + input->offset);
+        }
+    }
+    return props;
+}
+
+QMatrix4x4 NativeAnimatedModulePrivate::transformOf(const AnimatedNode& node) const {
+    // Composed in the order listed, as the transform style is
+    QMatrix4x4 matrix;
+    for (const QVariant& transform : node.config.value("transforms").toList()) {
+        const QVariantMap config = transform.toMap();
+        const QString property = config.value("property").toString();
+        // Angles are in radians, js converts the "deg" strings of static values
+        const double value = config.value("type").toString() == "animated" ? nodeValue(config.value("nodeTag").toInt())
+                                                                           : config.value("value").toDouble();
+
+        if (property == "translateX") {
+            matrix.translate(value, 0);
+        } else if (property == "translateY") {
+            matrix.translate(0, value);
+        } else if (property == "scale") {
+            matrix.scale(value, value);
+        } else if (property == "scaleX") {
+            matrix.scale(value, 1);
+        } else if (property == "scaleY") {
+            matrix.scale(1, value);
+        } else if (property == "rotate" || property == "rotateZ") {
+            matrix.rotate(qRadiansToDegrees(value), 0, 0, 1);
+        } else if (property == "rotateX") {
+            matrix.rotate(qRadiansToDegrees(value), 1, 0, 0);
+        } else if (property == "rotateY") {
+            matrix.rotate(qRadiansToDegrees(value), 0, 1, 0);
+        } else if (property == "skewX" || property == "skewY") {
+            QMatrix4x4 skew;
+            skew(property == "skewX" ? 0 : 1, property == "skewX" ? 1 : 0) = std::tan(value);
+            matrix *= skew;
+        } else if (property == "perspective" && value != 0) {
+            QMatrix4x4 perspective;
+            perspective(3, 2) = -1 / value;
+            matrix *= perspective;
+        } else {
+            qCWarning(NATIVEANIMATED) << "Unsupported transform property for native animation:" << property;
+        }
+    }
+    return matrix;
+}
+
+void NativeAnimatedModulePrivate::applyProps(AnimatedNode& node, const QVariantMap& props) {
+    if (node.viewTag == -1 || props.isEmpty() || !bridge)
+        return;
+
+    // Views still incubating get the animated values from js when they are created
+    QQuickItem* view = bridge->uiManager()->viewForTag(node.viewTag);
+    if (!view)
+        return;
+
+    for (auto it = props.constBegin(); it != props.constEnd(); ++it) {
+        node.appliedProps.insert(it.key());
+    }
+
+    AttachedProperties::get(view)->applyProperties(props);
+    Flexbox* flexbox = Flexbox::findFlexbox(view);
+    if (flexbox && flexbox->isDirty()) {
+        layoutRequested = true;
+    }
+}
+
+bool NativeAnimatedModulePrivate::stepDriver(AnimationDriver& driver, AnimatedNode& node, qint64 now) {
+    if (driver.startTime == -1) {
+        driver.startTime = now;
+        driver.fromValue = node.value;
+        driver.lastValue = node.value;
+    }
+    const double elapsed = now - driver.startTime;
+
+    if (driver.type == "frames")
+        return stepFrames(driver, node, elapsed);
+    if (driver.type == "spring")
+        return stepSpring(driver, node, elapsed);
+    return stepDecay(driver, node, elapsed);
+}
+
+bool NativeAnimatedModulePrivate::stepFrames(AnimationDriver& driver, AnimatedNode& node, double elapsed) {
+    const QVariantList frames = driver.config.value("frames").toList();
+    const double toValue = driver.config.value("toValue").toDouble();
+    if (frames.isEmpty()) {
+        node.value = toValue;
+        return true;
+    }
+
+    // Frames are interpolated, the display may refresh faster than they were sampled
+    const double frame = elapsed / FRAME_DURATION;
+    const int index = int(frame);
+    if (index >= frames.size() - 1) {
+        node.value = driver.fromValue + frames.last().toDouble() * (toValue - driver.fromValue);
+        return nextIteration(driver, node);
+    }
+
+    const double progress = frames[index].toDouble() +
+                            (frame - index) * (frames[index + 1].toDouble() - frames[index].toDouble());
+    node.value = driver.fromValue + progress * (toValue - driver.fromValue);
+    return false;
+}
+
+bool NativeAnimatedModulePrivate::stepSpring(AnimationDriver& driver, AnimatedNode& node, double elapsed) {
+    // Closed form of a damped harmonic oscillator, as SpringAnimation in js
+    const QVariantMap& config = driver.config;
+    const double toValue = config.value("toValue").toDouble();
+    const double stiffness = config.value("stiffness").toDouble();
+    const double damping = config.value("damping").toDouble();
+    const double mass = config.value("mass", 1).toDouble();
+    const double v0 = -config.value("initialVelocity").toDouble();
+    const double t = elapsed / 1000;
+
+    const double zeta = damping / (2 * std::sqrt(stiffness * mass));
+    const double omega0 = std::sqrt(stiffness / mass);
+    const double x0 = toValue - driver.fromValue;
+
+    double position;
+    double velocity;
+    if (zeta < 1) {
+        // Under damped
+        const double omega1 = omega0 * std::sqrt(1 - zeta * zeta);
+        const double envelope = std::exp(-zeta * omega0 * t);
+        const double a = (v0 + zeta * omega0 * x0) / omega1;
+        position = toValue - envelope * (a * std::sin(omega1 * t) + x0 * std::cos(omega1 * t));
+        velocity = zeta * omega0 * envelope * (std::sin(omega1 * t) * a + x0 * std::cos(omega1 * t)) -
+                   envelope * (std::cos(omega1 * t) * (v0 + zeta * omega0 * x0) - omega1 * x0 * std::sin(omega1 * t));
+    } else {
+        // Critically damped
+        const double envelope = std::exp(-omega0 * t);
+        position = toValue - envelope * (x0 + (v0 + omega0 * x0) * t);
+        velocity = envelope * (v0 * (t * omega0 - 1) + t * x0 * (omega0 * omega0));
+    }
+    node.value = position;
+
+    const bool overshooting = config.value("overshootClamping").toBool() && stiffness != 0 &&
+                              (driver.fromValue < toValue ? position > toValue : position < toValue);
+    const bool resting = std::abs(velocity) <= config.value("restSpeedThreshold", 0.001).toDouble() &&
+                         (stiffness == 0 ||
+                          std::abs(toValue - position) <= config.value("restDisplacementThreshold", 0.001).toDouble());
+    if (!overshooting && !resting)
+        return false;
+
+    if (stiffness != 0) {
+        node.value = toValue;
+    }
+    return nextIteration(driver, node);
+}
+
+bool NativeAnimatedModulePrivate::stepDecay(AnimationDriver& driver, AnimatedNode& node, double elapsed) {
+    const double velocity = driver.config.value("velocity").toDouble();
+    const double deceleration = driver.config.value("deceleration", 0.998).toDouble();
+
+    const double value = driver.fromValue +
+                         velocity / (1 - deceleration) * (1 - std::exp(-(1 - deceleration) * elapsed));
+    node.value = value;
+    if (std::abs(driver.lastValue - value) >= 0.1) {
+        driver.lastValue = value;
+        return false;
+    }
+    return nextIteration(driver, node);
+}
+
+bool NativeAnimatedModulePrivate::nextIteration(AnimationDriver& driver, AnimatedNode& node) {
+    // Iterations of -1 repeat the animation until it is stopped
+    if (driver.iterations != -1 && driver.currentIteration >= driver.iterations)
+        return true;
+
+    ++driver.currentIteration;
+    driver.startTime = -1;
+    node.value = driver.fromValue;
+    return false;
+}
+
+void NativeAnimatedModulePrivate::finishDriver(const AnimationDriver& driver, bool finished) {
+    if (driver.endCallback && bridge) {
+        driver.endCallback(bridge, QVariantList{QVariantMap{{"finished", finished}}});
+    }
+}
+
+void NativeAnimatedModulePrivate::stopAnimationsOfNode(int nodeTag) {
+    for (auto it = drivers.begin(); it != drivers.end();) {
+        if (it->nodeTag == nodeTag) {
+            finishDriver(it.value(), false);
+            it = drivers.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void NativeAnimatedModulePrivate::scheduleFrame() {
+    Q_Q(NativeAnimatedModule);
+
+    QQuickWindow* window = bridge && bridge->visualParent() ? bridge->visualParent()->window() : nullptr;
+    if (window != frameWindow) {
+        stopFrames();
+        frameWindow = window;
+    }
+
+    if (window) {
+        // Stepped right before the scene graph is synchronized, once per frame
+        QObject::connect(
+            window, &QQuickWindow::afterAnimating, q, &NativeAnimatedModule::onFrame, Qt::UniqueConnection);
+        window->update();
+    } else if (!fallbackTimer.isActive()) {
+        fallbackTimer.start();
+    }
+}
+
+void NativeAnimatedModulePrivate::stopFrames() {
+    Q_Q(NativeAnimatedModule);
+
+    if (frameWindow) {
+        QObject::disconnect(frameWindow, &QQuickWindow::afterAnimating, q, &NativeAnimatedModule::onFrame);
+    }
+    fallbackTimer.stop();
+}
+
+NativeAnimatedModule::NativeAnimatedModule(QObject* parent)
+    : QObject(parent), d_ptr(new NativeAnimatedModulePrivate(this)) {
+    Q_D(NativeAnimatedModule);
+    d->frameClock.start();
+    d->fallbackTimer.setTimerType(Qt::PreciseTimer);
+    d->fallbackTimer.setInterval(FALLBACK_FRAME_INTERVAL);
+    connect(&d->fallbackTimer, &QTimer::timeout, this, &NativeAnimatedModule::onFrame);
+}
+
+NativeAnimatedModule::~NativeAnimatedModule() {}
+
+void NativeAnimatedModule::setBridge(Bridge* bridge) {
+    d_func()->bridge = bridge;
+}
+
+QString NativeAnimatedModule::moduleName() {
+    return "NativeAnimatedModule";
+}
+
+void NativeAnimatedModule::createAnimatedNode(int tag, const QVariantMap& config) {
+    Q_D(NativeAnimatedModule);
+
+    const QString type = config.value("type").toString();
+    auto typeIt = nodeTypes().constFind(type);
+    if (typeIt == nodeTypes().constEnd()) {
+        qCWarning(NATIVEANIMATED) << "Unsupported animated node type:" << type << "tag=" << tag;
+        return;
+    }
+
+    AnimatedNode node;
+    node.type = typeIt.value();
+    node.config = config;
+    node.value = config.value("value").toDouble();
+    node.offset = config.value("offset").toDouble();
+    if (node.type == AnimatedNode::InterpolationNode) {
+        node.interpolation = Interpolation::fromConfig(config);
+        if (!node.interpolation.isValid()) {
+            qCWarning(NATIVEANIMATED) << "Invalid ranges of interpolation node; tag=" << tag;
+        }
+    } else if (node.type == AnimatedNode::DiffClampNode) {
+        node.lastInputValue = d->nodeValue(config.value("input").toInt());
+    }
+    d->nodes.insert(tag, node);
+}
+
+void NativeAnimatedModule::dropAnimatedNode(int tag) {
+    Q_D(NativeAnimatedModule);
+
+    auto it = d->nodes.find(tag);
+    if (it == d->nodes.end())
+        return;
+
+    for (int parent : it->parents) {
+        if (d->nodes.contains(parent)) {
+            d->nodes[parent].children.removeAll(tag);
+        }
+    }
+    for (int child : it->children) {
+        if (d->nodes.contains(child)) {
+            d->nodes[child].parents.removeAll(tag);
+        }
+    }
+    d->nodes.erase(it);
+    d->listenedTags.remove(tag);
+}
+
+void NativeAnimatedModule::connectAnimatedNodes(int parentTag, int childTag) {
+    Q_D(NativeAnimatedModule);
+
+    AnimatedNode* parent = d->node(parentTag, __func__);
+    AnimatedNode* child = d->node(childTag, __func__);
+    if (!parent || !child)
+        return;
+
+    parent->children.append(childTag);
+    child->parents.append(parentTag);
+}
+
+void NativeAnimatedModule::disconnectAnimatedNodes(int parentTag, int childTag) {
+    Q_D(NativeAnimatedModule);
+
+    AnimatedNode* parent = d->node(parentTag, __func__);
+    AnimatedNode* child = d->node(childTag, __func__);
+    if (!parent || !child)
+        return;
+
+    parent->children.removeOne(childTag);
+    child->parents.removeOne(parentTag);
+}
+
+void NativeAnimatedModule::startAnimatingNode(int animationId,
+                                              int nodeTag,
+                                              const QVariantMap& config,
+                                              const ModuleInterface::ListArgumentBlock& endCallback) {
+    Q_D(NativeAnimatedModule);
+
+    AnimatedNode* node = d->node(nodeTag, __func__);
+    if (!node)
+        return;
+
+    const QString type = config.value("type").toString();
+    if (node->type != AnimatedNode::ValueNode || (type != "frames" && type != "spring" && type != "decay")) {
+        qCWarning(NATIVEANIMATED) << "Unsupported native animation" << type << "of node; tag=" << nodeTag;
+        return;
+    }
+
+    AnimationDriver driver;
+    driver.nodeTag = nodeTag;
+    driver.type = type;
+    driver.config = config;
+    driver.endCallback = endCallback;
+    driver.iterations = config.value("iterations", 1).toInt();
+    d->drivers.insert(animationId, driver);
+
+    d->scheduleFrame();
+}
+
+void NativeAnimatedModule::stopAnimation(int animationId) {
+    Q_D(NativeAnimatedModule);
+
+    auto it = d->drivers.find(animationId);
+    if (it == d->drivers.end())
+        return;
+
+    d->finishDriver(it.value(), false);
+    d->drivers.erase(it);
+}
+
+void NativeAnimatedModule::setAnimatedNodeValue(int nodeTag, double value) {
+    Q_D(NativeAnimatedModule);
+
+    AnimatedNode* node = d->node(nodeTag, __func__);
+    if (!node)
+        return;
+
+    d->stopAnimationsOfNode(nodeTag);
+    node->value = value;
+    d->updateNodes({nodeTag});
+}
+
+void NativeAnimatedModule::setAnimatedNodeOffset(int nodeTag, double offset) {
+    Q_D(NativeAnimatedModule);
+
+    AnimatedNode* node = d->node(nodeTag, __func__);
+    if (!node)
+        return;
+
+    node->offset = offset;
+    d->updateNodes({nodeTag});
+}
+
+void NativeAnimatedModule::flattenAnimatedNodeOffset(int nodeTag) {
+    Q_D(NativeAnimatedModule);
+
+    AnimatedNode* node = d->node(nodeTag, __func__);
+    if (!node)
+        return;
+
+    node->value += node->offset;
+    node->offset = 0;
+}
+
+void NativeAnimatedModule::extractAnimatedNodeOffset(int nodeTag) {
+    Q_D(NativeAnimatedModule);
+
+    AnimatedNode* node = d->node(nodeTag, __func__);
+    if (!node)
+        return;
+
+    node->offset += node->value;
+    node->value = 0;
+}
+
+void NativeAnimatedModule::connectAnimatedNodeToView(int nodeTag, int viewTag) {
+    Q_D(NativeAnimatedModule);
+
+    AnimatedNode* node = d->node(nodeTag, __func__);
+    if (!node)
+        return;
+    if (node->type != AnimatedNode::PropsNode) {
+        qCWarning(NATIVEANIMATED) << "Only props nodes can be connected to views; tag=" << nodeTag;
+        return;
+    }
+    node->viewTag = viewTag;
+}
+
+void NativeAnimatedModule::disconnectAnimatedNodeFromView(int nodeTag, int viewTag) {
+    Q_D(NativeAnimatedModule);
+
+    AnimatedNode* node = d->node(nodeTag, __func__);
+    if (node && node->viewTag == viewTag) {
+        node->viewTag = -1;
+        node->appliedProps.clear();
+    }
+}
+
+void NativeAnimatedModule::restoreDefaultValues(int nodeTag) {
+    Q_D(NativeAnimatedModule);
+
+    auto it = d->nodes.find(nodeTag);
+    if (it == d->nodes.end() || it->type != AnimatedNode::PropsNode)
+        return;
+
+    // Null values reset the props of a view to their defaults
+    QVariantMap props;
+    for (const QString& prop : it->appliedProps) {
+        props.insert(prop, QVariant());
+    }
+    d->applyProps(it.value(), props);
+    it->appliedProps.clear();
+}
+
+void NativeAnimatedModule::startListeningToAnimatedNodeValue(int tag) {
+    d_func()->listenedTags.insert(tag);
+}
+
+void NativeAnimatedModule::stopListeningToAnimatedNodeValue(int tag) {
+    d_func()->listenedTags.remove(tag);
+}
+
+void NativeAnimatedModule::addAnimatedEventToView(int viewTag,
+                                                  const QString& eventName,
+                                                  const QVariantMap& eventMapping) {
+    Q_D(NativeAnimatedModule);
+
+    NativeAnimatedModulePrivate::EventMapping mapping;
+    mapping.nativeEventPath = eventMapping.value("nativeEventPath").toStringList();
+    mapping.nodeTag = eventMapping.value("animatedValueTag").toInt();
+    if (!d->node(mapping.nodeTag, __func__))
+        return;
+
+    d->eventMappings[qMakePair(viewTag, utilities::normalizeInputEventName(eventName))].append(mapping);
+}
+
+void NativeAnimatedModule::removeAnimatedEventFromView(int viewTag, const QString& eventName, int animatedNodeTag) {
+    Q_D(NativeAnimatedModule);
+
+    auto it = d->eventMappings.find(qMakePair(viewTag, utilities::normalizeInputEventName(eventName)));
+    if (it == d->eventMappings.end())
+        return;
+
+    for (int i = it->size() - 1; i >= 0; --i) {
+        if (it->at(i).nodeTag == animatedNodeTag) {
+            it->removeAt(i);
+        }
+    }
+    if (it->isEmpty()) {
+        d->eventMappings.erase(it);
+    }
+}
+
+void NativeAnimatedModule::handleEvent(int viewTag, const QString& eventName, const QVariantMap& eventData) {
+    Q_D(NativeAnimatedModule);
+
+    if (d->eventMappings.isEmpty())
+        return;
+    auto it = d->eventMappings.constFind(qMakePair(viewTag, eventName));
+    if (it == d->eventMappings.constEnd())
+        return;
+
+    QSet<int> updatedTags;
+    for (const NativeAnimatedModulePrivate::EventMapping& mapping : it.value()) {
+        QVariant value = eventData;
+        for (const QString& key : mapping.nativeEventPath) {
+            value = value.toMap().value(key);
+        }
+
+        auto node = d->nodes.find(mapping.nodeTag);
+        if (node != d->nodes.end() && value.isValid()) {
+            node->value = value.toDouble();
+            updatedTags.insert(mapping.nodeTag);
+        }
+    }
+    d->updateNodes(updatedTags);
+}
+
+bool NativeAnimatedModule::hasEventMapping(int viewTag, const QString& eventName) const {
+    return d_func()->eventMappings.contains(qMakePair(viewTag, eventName));
+}
+
+void NativeAnimatedModule::onFrame() {
+    Q_D(NativeAnimatedModule);
+
+    if (d->drivers.isEmpty()) {
+        d->stopFrames();
+        return;
+    }
+
+    const qint64 now = d->frameClock.elapsed();
+    QSet<int> updatedTags;
+    QList<int> finishedIds;
+    for (auto it = d->drivers.begin(); it != d->drivers.end(); ++it) {
+        auto node = d->nodes.find(it->nodeTag);
+        if (node == d->nodes.end()) {
+            finishedIds.push_back(it.key());
+            continue;
+        }
+        if (d->stepDriver(it.value(), node.value(), now)) {
+            finishedIds.push_back(it.key());
+        }
+        updatedTags.insert(it->nodeTag);
+    }
+
+    d->updateNodes(updatedTags);
+
+    for (int animationId : finishedIds) {
+        d->finishDriver(d->drivers.take(animationId), true);
+    }
+
+    if (d->drivers.isEmpty()) {
+        d->stopFrames();
+    } else {
+        d->scheduleFrame();
+    }
+}
@@ -0,0 +1,77 @@
+
+/**
+ * Copyright (c) 2017-present, Status Research and Development GmbH.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#ifndef NATIVEANIMATEDMODULE_H
+#define NATIVEANIMATEDMODULE_H
+
+#include <QLoggingCategory>
+#include <QObject>
+#include <QScopedPointer>
+#include <QVariant>
+
+#include "moduleinterface.h"
+
+Q_DECLARE_LOGGING_CATEGORY(NATIVEANIMATED)
+
+class NativeAnimatedModulePrivate;
+// Graph of Animated nodes created with useNativeDriver. Drivers step on the frame clock of the window and
+// the values they produce are applied to views natively, so animations don't wait for js.
+class NativeAnimatedModule : public QObject, public ModuleInterface {
+    Q_OBJECT
+    Q_INTERFACES(ModuleInterface)
+    Q_DECLARE_PRIVATE(NativeAnimatedModule)
+
+    Q_INVOKABLE void createAnimatedNode(int tag, const QVariantMap& config);
+    Q_INVOKABLE void dropAnimatedNode(int tag);
+    Q_INVOKABLE void connectAnimatedNodes(int parentTag, int childTag);
+    Q_INVOKABLE void disconnectAnimatedNodes(int parentTag, int childTag);
+
+    Q_INVOKABLE void startAnimatingNode(int animationId,
+                                        int nodeTag,
+                                        const QVariantMap& config,
+                                        const ModuleInterface::ListArgumentBlock& endCallback);
+    Q_INVOKABLE void stopAnimation(int animationId);
+
+    Q_INVOKABLE void setAnimatedNodeValue(int nodeTag, double value);
+    Q_INVOKABLE void setAnimatedNodeOffset(int nodeTag, double offset);
+    Q_INVOKABLE void flattenAnimatedNodeOffset(int nodeTag);
+    Q_INVOKABLE void extractAnimatedNodeOffset(int nodeTag);
+
+    Q_INVOKABLE void connectAnimatedNodeToView(int nodeTag, int viewTag);
+    Q_INVOKABLE void disconnectAnimatedNodeFromView(int nodeTag, int viewTag);
+    Q_INVOKABLE void restoreDefaultValues(int nodeTag);
+
+    Q_INVOKABLE void startListeningToAnimatedNodeValue(int tag);
+    Q_INVOKABLE void stopListeningToAnimatedNodeValue(int tag);
+
+    Q_INVOKABLE void addAnimatedEventToView(int viewTag, const QString& eventName, const QVariantMap& eventMapping);
+    Q_INVOKABLE void removeAnimatedEventFromView(int viewTag, const QString& eventName, int animatedNodeTag);
+
+public:
+    NativeAnimatedModule(QObject* parent = 0);
+    ~NativeAnimatedModule();
+
+    void setBridge(Bridge* bridge) override;
+    QString moduleName() override;
+
+    // Feeds the values mapped by addAnimatedEventToView() from an event sent by a view manager.
+    // Event name is normalized, as in "topScroll".
+    void handleEvent(int viewTag, const QString& eventName, const QVariantMap& eventData);
+    bool hasEventMapping(int viewTag, const QString& eventName) const;
+
+private Q_SLOTS:
+    void onFrame();
+
+private:
+    QScopedPointer<NativeAnimatedModulePrivate> d_ptr;
+};
+
+#endif // NATIVEANIMATEDMODULE_H
@@ -0,0 +1,82 @@
+
+/**
+ * Copyright (c) 2017-present, Status Research and Development GmbH.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "propertycache.h"
+
+#include <QHash>
+#include <QMetaProperty>
+#include <QObject>
+#include <QPair>
+
+namespace {
+
+// Dynamically created meta objects, like the ones of QML types, may be freed and their address reused,
+// so an entry also records what it was resolved against
+struct CachedIndex {
+    int index;
+    int propertyCount;
+    const char* className;
+};
+
+using PropertyKey = QPair<const QMetaObject*, const char*>;
+
+// Meta objects of destroyed QML instances leave their entries behind, the cache starts over past this
+const int MAX_CACHED_INDICES = 4096;
+
+QHash<PropertyKey, CachedIndex>& propertyIndices() {
+    static QHash<PropertyKey, CachedIndex> indices;
+    return indices;
+}
+
+bool isValid(const CachedIndex& cached, const QMetaObject* metaObject, const char* name) {
+    if (cached.propertyCount != metaObject->propertyCount() || qstrcmp(cached.className, metaObject->className()) != 0)
+        return false;
+    return cached.index < 0 || qstrcmp(metaObject->property(cached.index).name(), name) == 0;
+}
+
+} // namespace
+
+int PropertyCache::indexOfProperty(const QMetaObject* metaObject, const char* name) {
+    Q_ASSERT(metaObject && name);
+
+    QHash<PropertyKey, CachedIndex>& indices = propertyIndices();
+    const PropertyKey key(metaObject, name);
+    auto it = indices.constFind(key);
+    if (it != indices.constEnd() && isValid(it.value(), metaObject, name))
+        return it.value().index;
+
+    if (indices.size() >= MAX_CACHED_INDICES) {
+        indices.clear();
+    }
+    const int index = metaObject->indexOfProperty(name);
+    indices.insert(key, CachedIndex{index, metaObject->propertyCount(), metaObject->className()});
+    return index;
+}
+
+QVariant PropertyCache::read(const QObject* object, const char* name) {
+    const QMetaObject* metaObject = object->metaObject();
+    const int index = indexOfProperty(metaObject, name);
+    if (index < 0) {
+        // Dynamic properties aren't part of the meta object
+        return object->property(name);
+    }
+    return metaObject->property(index).read(object);
+}
+
+bool PropertyCache::write(QObject* object, const char* name, const QVariant& value) {
+    const QMetaObject* metaObject = object->metaObject();
+    const int index = indexOfProperty(metaObject, name);
+    if (index < 0) {
+        object->setProperty(name, value);
+        return false;
+    }
+    return metaObject->property(index).write(object, value);
+}
@@ -0,0 +1,35 @@
+
+/**
+ * Copyright (c) 2017-present, Status Research and Development GmbH.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#ifndef PROPERTYCACHE_H
+#define PROPERTYCACHE_H
+
+#include <QVariant>
+
+class QObject;
+struct QMetaObject;
+
+// Property access for hot paths, like building events. QObject::property() and QQmlProperty look
+// the name up through the whole class hierarchy on every call, here the index is resolved once per
+// meta object and name. Names are looked up by address, so they must outlive the cache: string literals
+// or other static strings. Only used from the GUI thread.
+class PropertyCache {
+public:
+    // -1 if the class has no such property
+    static int indexOfProperty(const QMetaObject* metaObject, const char* name);
+
+    // Names which aren't declared fall back to dynamic properties, like QObject::property() and
+    // QObject::setProperty() do
+    static QVariant read(const QObject* object, const char* name);
+    static bool write(QObject* object, const char* name, const QVariant& value);
+};
+
+#endif // PROPERTYCACHE_H
@@ -42,6 +42,9 @@ void PropertyHandler::applyProperties(const QVariantMap& properties) {
 
     for (const QString& property : properties.keys()) {
         QVariant propertyValue = properties.value(property);
+        if (m_tracksAppliedProperties) {
+            m_appliedProperties.insert(property);
+        }
 
         if (qmlProperties()->contains(property)) {
             QString qmlPropName = qmlProperties()->value(property);
@@ -50,7 +53,12 @@ void PropertyHandler::applyProperties(const QVariantMap& properties) {
         }
 
         if (m_flexbox) {
-            if (flexboxProperties()->contains(property)) {
+            // Styles go straight to the Yoga node, other Flexbox props through the meta object
+            if (m_flexbox->applyStyle(property, propertyValue)) {
+                if (m_setPropertyCallback) {
+                    m_setPropertyCallback(m_flexbox, property, propertyValue);
+                }
+            } else if (flexboxProperties()->contains(property)) {
                 QString qmlPropName = flexboxProperties()->value(property);
                 setValueToObjectProperty(
                     m_flexbox, property, qmlPropName, propertyValue, defaultFlexboxValues()->value(property));
@@ -66,6 +74,28 @@ void PropertyHandler::applyProperties(const QVariantMap& properties) {
     }
 }
 
+void PropertyHandler::resetProperties() {
+    for (const QString& property : m_appliedProperties) {
+        if (qmlProperties()->contains(property)) {
+            m_object->setProperty(qmlProperties()->value(property).toStdString().c_str(),
+                                  defaultQmlValues()->value(property));
+        }
+
+        if (m_flexbox && !m_flexbox->applyStyle(property, QVariant()) && flexboxProperties()->contains(property)) {
+            m_flexbox->setProperty(flexboxProperties()->value(property).toStdString().c_str(),
+                                   defaultFlexboxValues()->value(property));
+        }
+    }
+    m_appliedProperties.clear();
+}
+
+void PropertyHandler::setTracksAppliedProperties(bool tracks) {
+    m_tracksAppliedProperties = tracks;
+    if (!tracks) {
+        m_appliedProperties.clear();
+    }
+}
+
 QMetaProperty PropertyHandler::metaProperty(const QString& propertyName) {
     const QMetaObject* mo = nullptr;
     QString qmlPropName;
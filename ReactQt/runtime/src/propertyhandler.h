@@ -20,6 +20,7 @@
 #include <QMetaProperty>
 #include <QMutex>
 #include <QObject>
+#include <QSet>
 
 class QQuickItem;
 class Flexbox;
@@ -58,6 +59,10 @@ public:
 
     virtual QMap<QString, QString> availableProperties();
     virtual void applyProperties(const QVariantMap& properties);
+    // Restores default values of all properties applied since the last reset. Applied properties are
+    // only recorded for objects which may be reset, see setTracksAppliedProperties().
+    void resetProperties();
+    void setTracksAppliedProperties(bool tracks);
     QMetaProperty metaProperty(const QString& propertyName);
 
 private:
@@ -75,6 +80,8 @@ private:
     QObject* m_object = nullptr;
     Flexbox* m_flexbox = nullptr;
     QString m_className;
+    QSet<QString> m_appliedProperties;
+    bool m_tracksAppliedProperties = false;
 
     const QMap<QString, QString>* qmlProperties();
     const QMap<QString, QString>* flexboxProperties();
@@ -45,8 +45,8 @@ React.Item {
 
         //svg images sometimes contain internal height and width specification and gets
         //blurry when resized. To avoid this we set sourceSize that supercedes internal svg settings
-        sourceSize.width: isSVG ? flexbox.p_width : undefined
-        sourceSize.height: isSVG ? flexbox.p_height : undefined
+        sourceSize.width: isSVG ? imageRoot.width : undefined
+        sourceSize.height: isSVG ? imageRoot.height : undefined
         asynchronous: true
     }
 
@@ -7,6 +7,7 @@ ListView{
 
     property var scrollViewManager: null
     property bool p_onScroll: false
+    property int p_scrollEventThrottle: 0
     property var flexbox: React.Flexbox {control: scrollViewRoot; viewManager: scrollViewManager}
     property bool p_enableArrayScrollingOptimization: false
     property int p_headerHeight: 0
@@ -14,17 +15,33 @@ ListView{
     property bool p_inverted: false
     property bool p_showsHorizontalScrollIndicator: true
     property bool p_showsVerticalScrollIndicator: true
+    property bool p_windowed: false
+    property int p_overscanRowCount: 10
+    property bool p_onVisibleRangeChange: false
 
     clip: true
     highlightFollowsCurrentItem: false
 
     onCountChanged: {
-        if(scrollViewManager)
+        if(scrollViewManager) {
             scrollViewManager.sendOnLayoutToJs(scrollViewRoot,
                                                contentX,
                                                contentY,
                                                contentItem.childrenRect.width,
                                                contentItem.childrenRect.height);
+            updateVisibleRange();
+        }
+    }
+    onContentXChanged: updateVisibleRange()
+    onContentYChanged: updateVisibleRange()
+    onWidthChanged: updateVisibleRange()
+    onHeightChanged: updateVisibleRange()
+    onP_windowedChanged: updateVisibleRange()
+    onP_overscanRowCountChanged: updateVisibleRange()
+
+    function updateVisibleRange() {
+        if(scrollViewManager)
+            scrollViewManager.updateVisibleRange(scrollViewRoot);
     }
 
     verticalLayoutDirection: p_inverted ? ListView.BottomToTop : ListView.TopToBottom
@@ -38,12 +55,20 @@ ListView{
 
     delegate: Item {
         id: componentId
+        property var row: model.display
         height: model.display.height
         width: model.display.width
         Component.onCompleted: {
             model.display.parent = componentId
             model.display.anchors.centerIn = componentId
         }
+        // Rows scrolled out of the cache buffer leave the scene until a delegate shows them again
+        Component.onDestruction: {
+            if(row && row.parent === componentId) {
+                row.anchors.centerIn = undefined
+                row.parent = null
+            }
+        }
     }
 
     onFlickingChanged: {
@@ -7,6 +7,7 @@ Flickable {
 
     property var scrollViewManager: null
     property bool p_onScroll: false
+    property int p_scrollEventThrottle: 0
     property var flexbox: React.Flexbox {control: scrollViewRoot; viewManager: scrollViewManager}
     property bool p_enableArrayScrollingOptimization: false
     property int p_headerHeight: 0
@@ -29,17 +29,19 @@ TextEdit {
 
     property string typeName: "ReactText"
     property var textManager
-    property string decoratedText
     //ReactText components can be nested. This property indicates if item is parent
     //of current text blocks.
     property bool textIsTopInBlock: parent ? (parent.typeName ? (parent.typeName === "ReactText" ? false : true) : true) : true
     onTextIsTopInBlockChanged: {
         manageFlexbox()
         updateMeasureFunction()
+        markTextDirty()
+    }
+    onTextManagerChanged: {
+        updateMeasureFunction()
+        markTextDirty()
     }
-    onTextManagerChanged: updateMeasureFunction()
 
-    text: textIsTopInBlock ? decoratedText : ""
     horizontalAlignment: horizontalAlignmentFromTextAlign(p_textAlign)
     textFormat: Text.RichText
     wrapMode: Text.Wrap
@@ -56,30 +58,19 @@ TextEdit {
     }
 
 
-    onP_allowFontScalingChanged: updateHtmlText();
-    onP_fontFamilyChanged: updateHtmlText();
-    onP_fontSizeChanged: updateHtmlText();
-    onP_highlightedChanged: updateHtmlText();
-    onP_colorChanged: updateHtmlText();
-    onP_fontStyleChanged: updateHtmlText();
-    onP_fontWeightChanged: updateHtmlText();
-    onP_letterSpacingChanged: updateHtmlText();
-    onP_lineHeightChanged: updateHtmlText();
-    onP_textAlignChanged: updateHtmlText();
-    onP_textDecorationLineChanged: updateHtmlText();
-    onP_textDecorationStyleChanged: updateHtmlText();
-    onP_textDecorationColorChanged: updateHtmlText();
-    onP_writingDirectionChanged: updateHtmlText();
-    onP_numberOfLinesChanged: updateHtmlText();
+    //Style props are applied in batches, the block is rebuilt once after all of them are set
+    function onJsPropertiesSet() {
+        markTextDirty()
+    }
 
 
     onChildrenChanged: {
         subscribeToChildrenTextChanges()
-        updateHtmlText()
+        markTextDirty()
     }
     onParentChanged: {
         if(parent){
-            updateHtmlText()
+            markTextDirty()
         }
     }
 
@@ -104,15 +95,13 @@ TextEdit {
         }
     }
 
+    //Nested texts update their block themselves, raw texts have no text manager
     function subscribeToChildrenTextChanges() {
         for (var i = 0; i < textRoot.children.length; i++)
         {
             var child = textRoot.children[i];
-            if(isText(child)) {
-                child.decoratedTextChanged.connect(updateHtmlText)
-            }
-            else if(isRawText(child)) {
-                child.p_textChanged.connect(updateHtmlText)
+            if(isRawText(child)) {
+                child.p_textChanged.connect(markTextDirty)
             }
         }
     }
@@ -128,66 +117,14 @@ TextEdit {
         }
     }
 
-    function textToHtml(textString) {
-
-        //get props values, own or nested
-        var fontFamily = textManager.nestedPropertyValue(textRoot, "p_fontFamily")
-        var color = textManager.nestedPropertyValue(textRoot, "p_color")
-        var backgroundColor = textManager.nestedPropertyValue(textRoot, "p_backgroundColor")
-        var fontWeight = textManager.nestedPropertyValue(textRoot, "p_fontWeight")
-        var fontSize = textManager.nestedPropertyValue(textRoot, "p_fontSize")
-        var fontStyle = textManager.nestedPropertyValue(textRoot, "p_fontStyle")
-        var textDecorLine = textManager.nestedPropertyValue(textRoot, "p_textDecorationLine")
-
-        var result = "<span style=\"white-space: pre; " + (fontFamily ? ("font-family:"+fontFamily+";") : "")
-                + (fontSize? ("font-size:"+fontSize+"pt;") : "")
-                + (color ? ("color:"+color+";") : "")
-                + ( !Qt.colorEqual(backgroundColor, "transparent") ? ("background-color:"+backgroundColor+";") : "")
-                + (fontStyle ? ("font-style:"+fontStyle+";") : "")
-                + (fontWeight ? ("font-weight:"+fontWeight+";") : "")
-                + (textDecorLine ? ("text-decoration:"+textDecorLine+";") : "")
-                + "\">"
-                + textManager.escape(textString) + "</span>";
-
-        return result.replace(/\n/g, '<br>');
-    }
-
-
-    function updateHtmlText() {
-        var htmlString = "";
-
-        var oldDecoratedText = decoratedText;
-
-        for (var i = 0; i < textRoot.children.length; i++)
-        {
-            var child = textRoot.children[i];
-            if(isText(child) && child.decoratedText) {
-                var nestedText = child.decoratedText;
-                nestedText = "<a href=\"" + i + "\" style=\"text-decoration: none\">" + nestedText + "</a>"; 
-                htmlString += nestedText
-            }
-            else if(isRawText(child) && child.p_text) {
-                htmlString += textToHtml(child.p_text)
-            }
-        }
-
-        var textHasChanged = (oldDecoratedText != htmlString);
-        if(textHasChanged) {
-            decoratedText = htmlString;
-            if (textRoot.flexbox) {
-                textRoot.flexbox.markDirty();
-            }
+    //Text of the whole block is built natively by the text manager and set to the
+    //document of the top text item, once per batch before layout
+    function markTextDirty() {
+        if(textManager) {
+            textManager.markTextDirty(textRoot)
         }
     }
 
-    function isText(obj)
-    {
-        if(obj && obj.typeName && obj.typeName === "ReactText")
-            return true
-        else
-            return false
-    }
-
     function isRawText(obj)
     {
         if(obj && obj.typeName && obj.typeName === "ReactRawText")
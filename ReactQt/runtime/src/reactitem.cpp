@@ -11,13 +11,212 @@
  *
  */
 
-#include <QPainter>
+#include <QSGGeometryNode>
+#include <QSGVertexColorMaterial>
+#include <QtMath>
 
 #include "layout/flexbox.h"
 #include "reactitem.h"
 #include "utilities.h"
 
 namespace {
+const int CORNER_SEGMENTS = 8;
+// Edges fade out over one unit, half inside and half outside of them, like QQuickRectangle does
+const qreal ANTIALIASING_FRINGE = 0.5;
+// Dash and gap lengths in border widths, same as RN on Android
+const qreal DOT_LENGTH = 1;
+const qreal DASH_LENGTH = 3;
+
+enum Side { Top = 0, Right, Bottom, Left };
+
+typedef QSGGeometry::ColoredPoint2D Vertex;
+
+// Background and borders are vertex colored geometry nodes, so each side can have its own color
+// and edges are antialiased by an alpha fringe
+class ReactItemNode : public QSGNode {
+public:
+    ReactItemNode() {
+        background = createGeometryNode();
+        border = createGeometryNode();
+    }
+
+    QSGGeometryNode* background;
+    QSGGeometryNode* border;
+
+private:
+    QSGGeometryNode* createGeometryNode() {
+        QSGGeometryNode* node = new QSGGeometryNode;
+        QSGGeometry* geometry = new QSGGeometry(QSGGeometry::defaultAttributes_ColoredPoint2D(), 0);
+        geometry->setDrawingMode(QSGGeometry::DrawTriangles);
+        node->setGeometry(geometry);
+        node->setFlag(QSGNode::OwnsGeometry);
+        node->setMaterial(new QSGVertexColorMaterial);
+        node->setFlag(QSGNode::OwnsMaterial);
+        appendChildNode(node);
+        return node;
+    }
+};
+
+void setVertices(QSGGeometryNode* node, const QVector<Vertex>& vertices) {
+    QSGGeometry* geometry = node->geometry();
+    geometry->allocate(vertices.size());
+    Vertex* data = geometry->vertexDataAsColoredPoint2D();
+    for (int i = 0; i < vertices.size(); ++i) {
+        data[i] = vertices[i];
+    }
+    node->markDirty(QSGNode::DirtyGeometry);
+}
+
+Vertex vertex(const QPointF& point, const QColor& color, qreal coverage) {
+    // Vertex colors are premultiplied
+    const qreal alpha = color.alphaF() * coverage;
+    Vertex v;
+    v.set(point.x(),
+          point.y(),
+          qRound(color.redF() * alpha * 255),
+          qRound(color.greenF() * alpha * 255),
+          qRound(color.blueF() * alpha * 255),
+          qRound(alpha * 255));
+    return v;
+}
+
+// Two triangles between edges a0-a1 and b0-b1
+void appendQuad(QVector<Vertex>& vertices, const Vertex& a0, const Vertex& a1, const Vertex& b0, const Vertex& b1) {
+    vertices << a0 << a1 << b0;
+    vertices << b0 << a1 << b1;
+}
+
+QPointF normalized(const QPointF& vector) {
+    const qreal length = qSqrt(QPointF::dotProduct(vector, vector));
+    return length > 0 ? vector / length : QPointF();
+}
+
+QPointF lerp(const QPointF& from, const QPointF& to, qreal t) {
+    return from + (to - from) * t;
+}
+
+// Outwards offsets of a clockwise outline's points, one unit away from both adjacent edges.
+// Points of corners without a radius coincide, they all get the miter of the corner.
+QVector<QPointF> outlineNormals(const QVector<QPointF>& outline) {
+    const int count = outline.size();
+    QVector<QPointF> normals(count);
+    for (int i = 0; i < count; ++i) {
+        int previous = (i + count - 1) % count;
+        while (previous != i && outline[previous] == outline[i]) {
+            previous = (previous + count - 1) % count;
+        }
+        int next = (i + 1) % count;
+        while (next != i && outline[next] == outline[i]) {
+            next = (next + 1) % count;
+        }
+        if (previous == i || next == i)
+            continue;
+
+        const QPointF previousEdge = normalized(outline[i] - outline[previous]);
+        const QPointF nextEdge = normalized(outline[next] - outline[i]);
+        const QPointF previousNormal(previousEdge.y(), -previousEdge.x());
+        const QPointF nextNormal(nextEdge.y(), -nextEdge.x());
+        const qreal cosine = QPointF::dotProduct(previousNormal, nextNormal);
+        normals[i] = cosine > -0.99 ? (previousNormal + nextNormal) / (1 + cosine) : previousNormal;
+    }
+    return normals;
+}
+
+// Cross section of the border ring at one point, from the outer fringe to the inner one
+struct BorderSection {
+    Vertex outerFringe;
+    Vertex outerEdge;
+    Vertex innerEdge;
+    Vertex innerFringe;
+};
+
+BorderSection borderSection(const QPointF& outer,
+                            const QPointF& outerNormal,
+                            const QPointF& inner,
+                            const QPointF& innerNormal,
+                            const QColor& color) {
+    QPointF outerEdge = outer - outerNormal * ANTIALIASING_FRINGE;
+    QPointF innerEdge = inner + innerNormal * ANTIALIASING_FRINGE;
+    qreal coverage = 1;
+
+    // Borders thinner than the fringes are drawn fainter instead
+    const qreal width = qSqrt(QPointF::dotProduct(outer - inner, outer - inner));
+    if (width < 2 * ANTIALIASING_FRINGE) {
+        outerEdge = innerEdge = (outer + inner) / 2;
+        coverage = width / (2 * ANTIALIASING_FRINGE);
+    }
+
+    return BorderSection{vertex(outer + outerNormal * ANTIALIASING_FRINGE, color, 0),
+                         vertex(outerEdge, color, coverage),
+                         vertex(innerEdge, color, coverage),
+                         vertex(inner - innerNormal * ANTIALIASING_FRINGE, color, 0)};
+}
+
+void appendBorderSections(QVector<Vertex>& vertices, const BorderSection& from, const BorderSection& to) {
+    appendQuad(vertices, from.outerFringe, to.outerFringe, from.outerEdge, to.outerEdge);
+    appendQuad(vertices, from.outerEdge, to.outerEdge, from.innerEdge, to.innerEdge);
+    appendQuad(vertices, from.innerEdge, to.innerEdge, from.innerFringe, to.innerFringe);
+}
+
+// Appends a quarter of an ellipse, clockwise in item coordinates. Corners without a radius
+// still produce the same number of (coinciding) points, so outer and inner outlines always
+// pair up vertex by vertex.
+void appendCorner(QVector<QPointF>& outline, const QPointF& center, qreal rx, qreal ry, qreal startAngle) {
+    for (int i = 0; i <= CORNER_SEGMENTS; ++i) {
+        const qreal angle = qDegreesToRadians(startAngle + 90.0 * i / CORNER_SEGMENTS);
+        outline.push_back(QPointF(center.x() + rx * qCos(angle), center.y() + ry * qSin(angle)));
+    }
+}
+
+// Outline of a rect with per corner radii, starting at the top left corner.
+// radii are {rx, ry} pairs for top left, top right, bottom right and bottom left corners.
+QVector<QPointF> roundedRectOutline(const QRectF& rect, const QSizeF radii[4]) {
+    QVector<QPointF> outline;
+    outline.reserve(4 * (CORNER_SEGMENTS + 1));
+    appendCorner(outline,
+                 QPointF(rect.left() + radii[0].width(), rect.top() + radii[0].height()),
+                 radii[0].width(),
+                 radii[0].height(),
+                 180);
+    appendCorner(outline,
+                 QPointF(rect.right() - radii[1].width(), rect.top() + radii[1].height()),
+                 radii[1].width(),
+                 radii[1].height(),
+                 270);
+    appendCorner(outline,
+                 QPointF(rect.right() - radii[2].width(), rect.bottom() - radii[2].height()),
+                 radii[2].width(),
+                 radii[2].height(),
+                 0);
+    appendCorner(outline,
+                 QPointF(rect.left() + radii[3].width(), rect.bottom() - radii[3].height()),
+                 radii[3].width(),
+                 radii[3].height(),
+                 90);
+    return outline;
+}
+
+// Fills a convex outline, as a fan around center, fading out across its edge
+void appendFilledOutline(QVector<Vertex>& vertices,
+                         const QPointF& center,
+                         const QVector<QPointF>& outline,
+                         const QVector<QPointF>& normals,
+                         const QColor& color) {
+    const int count = outline.size();
+    const Vertex centerVertex = vertex(center, color, 1);
+    for (int i = 0; i < count; ++i) {
+        const int next = (i + 1) % count;
+        const Vertex edge = vertex(outline[i] - normals[i] * ANTIALIASING_FRINGE, color, 1);
+        const Vertex nextEdge = vertex(outline[next] - normals[next] * ANTIALIASING_FRINGE, color, 1);
+        vertices << centerVertex << edge << nextEdge;
+        appendQuad(vertices,
+                   edge,
+                   nextEdge,
+                   vertex(outline[i] + normals[i] * ANTIALIASING_FRINGE, color, 0),
+                   vertex(outline[next] + normals[next] * ANTIALIASING_FRINGE, color, 0));
+    }
+}
+
 Qt::PenStyle borderStyleToPenStyle(const QString& borderStyle) {
     if (borderStyle == "dotted")
         return Qt::DotLine;
@@ -58,42 +257,12 @@ public:
         0,
     };
     Qt::PenStyle borderStyle = Qt::SolidLine;
-    QRectF outerRects[4];
-    QRectF innerRects[4];
     QVector<float> transform;
 
-    ReactItemPrivate(ReactItem* q) : q_ptr(q) {}
-
-    void calculateCornerRects(const QRectF& otr, const QRectF& inr) {
-        outerRects[0] = QRectF(otr.topLeft(), QSizeF(borderRadiuses[0] * 2, borderRadiuses[0] * 2));
-        outerRects[1] = QRectF(otr.topRight().x() - borderRadiuses[1] * 2,
-                               otr.topRight().y(),
-                               borderRadiuses[1] * 2,
-                               borderRadiuses[1] * 2);
-        outerRects[2] = QRectF(otr.bottomRight().x() - borderRadiuses[2] * 2,
-                               otr.bottomRight().y() - borderRadiuses[2] * 2,
-                               borderRadiuses[2] * 2,
-                               borderRadiuses[2] * 2);
-        outerRects[3] = QRectF(otr.bottomLeft().x(),
-                               otr.bottomLeft().y() - borderRadiuses[3] * 2,
-                               borderRadiuses[3] * 2,
-                               borderRadiuses[3] * 2);
-
-        innerRects[0] =
-            QRectF(inr.topLeft(),
-                   QSizeF((borderRadiuses[0] - borderWidths[3]) * 2, (borderRadiuses[0] - borderWidths[0]) * 2));
-        innerRects[1] = QRectF(inr.topRight().x() - (borderRadiuses[1] - borderWidths[1]) * 2,
-                               inr.topRight().y(),
-                               (borderRadiuses[1] - borderWidths[1]) * 2,
-                               (borderRadiuses[1] - borderWidths[0]) * 2);
-        innerRects[2] = QRectF(inr.bottomRight().x() - (borderRadiuses[2] - borderWidths[1]) * 2,
-                               inr.bottomRight().y() - (borderRadiuses[2] - borderWidths[2]) * 2,
-                               (borderRadiuses[2] - borderWidths[1]) * 2,
-                               (borderRadiuses[2] - borderWidths[2]) * 2);
-        innerRects[3] = QRectF(inr.bottomLeft().x(),
-                               inr.bottomLeft().y() - (borderRadiuses[3] - borderWidths[2]) * 2,
-                               (borderRadiuses[3] - borderWidths[3]) * 2,
-                               (borderRadiuses[3] - borderWidths[2]) * 2);
+    ReactItemPrivate(ReactItem* q) : q_ptr(q) {
+        for (int i = 0; i < 4; ++i) {
+            borderColors[i] = borderColor;
+        }
     }
 
     ReactItem* q_ptr;
@@ -402,181 +571,124 @@ QVector<float> ReactItem::transform() const {
 void ReactItem::setTransform(QVector<float>& transform) {
     Q_D(ReactItem);
     d->transform = transform;
-    QQmlListReference r(this, "transform");
-    r.clear();
-    r.append(new utilities::MatrixTransform(transform, this));
+    utilities::setItemTransform(this, transform);
 }
 
-ReactItem::ReactItem(QQuickItem* parent) : QQuickPaintedItem(parent), d_ptr(new ReactItemPrivate(this)) {
+ReactItem::ReactItem(QQuickItem* parent) : QQuickItem(parent), d_ptr(new ReactItemPrivate(this)) {
+    setFlag(QQuickItem::ItemHasContents);
     setAcceptedMouseButtons(Qt::LeftButton | Qt::RightButton);
 }
 
 ReactItem::~ReactItem() {}
 
-void ReactItem::paint(QPainter* painter) {
+void ReactItem::geometryChanged(const QRectF& newGeometry, const QRectF& oldGeometry) {
+    QQuickItem::geometryChanged(newGeometry, oldGeometry);
+    if (newGeometry.size() != oldGeometry.size()) {
+        update();
+    }
+}
+
+QSGNode* ReactItem::updatePaintNode(QSGNode* oldNode, UpdatePaintNodeData*) {
     Q_D(ReactItem);
 
-    painter->setRenderHint(QPainter::Antialiasing);
+    const QRectF area = boundingRect();
+    if (area.isEmpty()) {
+        delete oldNode;
+        return nullptr;
+    }
 
-    QRectF area(QPointF(0, 0), QSizeF(width(), height()));
+    ReactItemNode* node = static_cast<ReactItemNode*>(oldNode);
+    if (!node) {
+        node = new ReactItemNode;
+    }
 
-    // TODO; support variant widths with variant radii
-    QRectF border = area.adjusted(d->borderWidths[3], d->borderWidths[0], -d->borderWidths[1], -d->borderWidths[2]);
+    const qreal* widths = d->borderWidths;
+    const QRectF inner = area.adjusted(widths[Left], widths[Top], -widths[Right], -widths[Bottom]);
+
+    // Radii can't be larger than half of the smaller dimension
+    const qreal maxRadius = qMin(area.width(), area.height()) / 2;
+    QSizeF outerRadii[4];
+    QSizeF innerRadii[4];
+    const int horizontalSide[4] = {Left, Right, Right, Left};
+    const int verticalSide[4] = {Top, Top, Bottom, Bottom};
+    for (int corner = 0; corner < 4; ++corner) {
+        const qreal radius = qBound(0.0, d->borderRadiuses[corner], maxRadius);
+        outerRadii[corner] = QSizeF(radius, radius);
+        innerRadii[corner] = QSizeF(qMax(0.0, radius - widths[horizontalSide[corner]]),
+                                    qMax(0.0, radius - widths[verticalSide[corner]]));
+    }
 
-    if (border != area) {
-        if (d->customBorderWidths || d->customBorderColors || d->customBorderRadius) {
-            if (!d->customBorderColors && !(d->borderRadius > 0 || d->customBorderRadius)) {
-                QPainterPath path;
-                path.addRect(area);
-                path.addRect(border);
-                painter->fillPath(path, d->borderColor);
-                if (d->backgroundColor.isValid() && d->backgroundColor.alpha() != 0) {
-                    QPainterPath ap;
-                    ap.addRect(area);
-                    painter->fillPath(ap.subtracted(path), d->backgroundColor);
-                }
-            } else {
-                if (d->backgroundColor.isValid() && d->backgroundColor.alpha() != 0) {
-                    QPainterPath backgroundPath;
-                    backgroundPath.addRect(area);
-                    painter->fillPath(backgroundPath, d->backgroundColor);
-                }
+    const QVector<QPointF> outer = roundedRectOutline(area, outerRadii);
+    const QVector<QPointF> outerNormals = outlineNormals(outer);
+    const int count = outer.size();
 
-                d->calculateCornerRects(area, border);
-                QPainterPath path;
-                // TODO: background
-
-                // top
-                if (d->borderRadiuses[0] > 0) {
-                    if (!d->innerRects[0].isEmpty()) {
-                        path.arcMoveTo(d->innerRects[0], 90);
-                        path.arcTo(d->innerRects[0], 90, 45);
-                    } else {
-                        path.moveTo(border.topLeft());
-                    }
-                    path.arcTo(d->outerRects[0], -225, -45);
-                } else {
-                    path.moveTo(border.topLeft());
-                    path.lineTo(area.topLeft());
-                }
-                if (d->borderRadiuses[1] > 0) {
-                    path.arcTo(d->outerRects[1], -270, -45);
-                    if (!d->innerRects[1].isEmpty()) {
-                        path.arcTo(d->innerRects[1], 45, 45);
-                    } else {
-                        path.lineTo(border.topRight());
-                    }
-                } else {
-                    path.lineTo(area.topRight());
-                    path.lineTo(border.topRight());
-                }
-                path.closeSubpath();
-                painter->fillPath(path, d->borderColors[0]);
-
-                // right
-                path = QPainterPath();
-                if (d->borderRadiuses[1] > 0) {
-                    if (!d->innerRects[1].isEmpty()) {
-                        path.arcMoveTo(d->innerRects[1], 0);
-                        path.arcTo(d->innerRects[1], 0, 45);
-                    } else {
-                        path.moveTo(border.topRight());
-                    }
-                    path.arcTo(d->outerRects[1], 45, -45);
-                } else {
-                    path.moveTo(border.topRight());
-                    path.lineTo(area.topRight());
-                }
-                if (d->borderRadiuses[2] > 0) {
-                    path.arcTo(d->outerRects[2], 0, -45);
-                    if (!d->innerRects[2].isEmpty()) {
-                        path.arcTo(d->innerRects[2], -45, 45);
-                    } else {
-                        path.lineTo(border.bottomRight());
-                    }
-                } else {
-                    path.lineTo(area.bottomRight());
-                    path.lineTo(border.bottomRight());
-                }
-                path.closeSubpath();
-                painter->fillPath(path, d->borderColors[1]);
-
-                // bottom
-                path = QPainterPath();
-                if (d->borderRadiuses[2] > 0) {
-                    if (!d->innerRects[2].isEmpty()) {
-                        path.arcMoveTo(d->innerRects[2], -90);
-                        path.arcTo(d->innerRects[2], -90, 45);
-                    } else {
-                        path.moveTo(border.bottomRight());
-                    }
-                    path.arcTo(d->outerRects[2], -45, -45);
-                } else {
-                    path.moveTo(border.bottomRight());
-                    path.lineTo(area.bottomRight());
-                }
-                if (d->borderRadiuses[3] > 0) {
-                    path.arcTo(d->outerRects[3], -90, -45);
-                    if (!d->innerRects[3].isEmpty()) {
-                        path.arcTo(d->innerRects[3], -135, -45);
-                    } else {
-                        path.lineTo(border.bottomLeft());
-                    }
-                } else {
-                    path.lineTo(area.bottomLeft());
-                    path.lineTo(border.bottomLeft());
-                }
-                path.closeSubpath();
-                painter->fillPath(path, d->borderColors[2]);
-
-                // left
-                path = QPainterPath();
-                if (d->borderRadiuses[3] > 0) {
-                    if (!d->innerRects[3].isEmpty()) {
-                        path.arcMoveTo(d->innerRects[3], -180);
-                        path.arcTo(d->innerRects[3], -180, 45);
-                    } else {
-                        path.moveTo(border.bottomLeft());
-                    }
-                    path.arcTo(d->outerRects[3], -135, -45);
-                } else {
-                    path.moveTo(border.bottomLeft());
-                    path.lineTo(area.bottomLeft());
-                }
-                if (d->borderRadiuses[0] > 0) {
-                    path.arcTo(d->outerRects[0], -180, -45);
-                    if (!d->innerRects[0].isEmpty()) {
-                        path.arcTo(d->innerRects[0], -225, 45);
-                    } else {
-                        path.lineTo(border.topLeft());
-                    }
-                } else {
-                    path.lineTo(area.topLeft());
-                    path.lineTo(border.topLeft());
-                }
-                path.closeSubpath();
-                painter->fillPath(path, d->borderColors[3]);
+    // Background fills the whole border box
+    QVector<Vertex> background;
+    if (d->backgroundColor.isValid() && d->backgroundColor.alpha() != 0) {
+        appendFilledOutline(background, area.center(), outer, outerNormals, d->backgroundColor);
+    }
+    setVertices(node->background, background);
+
+    // Border ring is split into sides in the middle of every corner. It's walked from the start
+    // of the top side, so dashes run along each side without a break at the segment ends.
+    QVector<Vertex> border;
+    if (inner != area) {
+        const QVector<QPointF> innerOutline = roundedRectOutline(inner, innerRadii);
+        const QVector<QPointF> innerNormals = outlineNormals(innerOutline);
+        const int cornerPoints = CORNER_SEGMENTS + 1;
+        int currentSide = -1;
+        qreal sideLength = 0;
+        for (int step = 0; step < count; ++step) {
+            const int i = (step + CORNER_SEGMENTS / 2) % count;
+            const int next = (i + 1) % count;
+            const int corner = i / cornerPoints;
+
+            int side = corner;
+            if (i % cornerPoints < CORNER_SEGMENTS / 2) {
+                side = (corner + 3) % 4;
             }
-        } else {
-            QPainterPath path;
-            path.addRoundedRect(border, d->borderRadius, d->borderRadius);
-            if (d->backgroundColor.isValid() && d->backgroundColor.alpha() != 0) {
-                painter->fillPath(path, d->backgroundColor);
+            if (side != currentSide) {
+                currentSide = side;
+                sideLength = 0;
             }
-            if (d->borderColor.alpha() != 0) {
-                QPen pen(d->borderStyle);
-                pen.setColor(d->borderColor);
-                pen.setWidthF(d->borderWidth);
-                pen.setJoinStyle(Qt::MiterJoin);
-                painter->setPen(pen);
-                painter->drawPath(path);
+
+            // Dashes are measured along the middle of the ring
+            const QPointF middle = (outer[i] + innerOutline[i]) / 2;
+            const QPointF nextMiddle = (outer[next] + innerOutline[next]) / 2;
+            const qreal length = qSqrt(QPointF::dotProduct(nextMiddle - middle, nextMiddle - middle));
+            const qreal start = sideLength;
+            sideLength += length;
+
+            const qreal width = widths[side];
+            const QColor& color = d->borderColors[side];
+            if (width <= 0 || color.alpha() == 0)
+                continue;
+
+            auto section = [&](qreal t) {
+                return borderSection(lerp(outer[i], outer[next], t),
+                                     lerp(outerNormals[i], outerNormals[next], t),
+                                     lerp(innerOutline[i], innerOutline[next], t),
+                                     lerp(innerNormals[i], innerNormals[next], t),
+                                     color);
+            };
+
+            if (d->borderStyle == Qt::SolidLine || length <= 0) {
+                appendBorderSections(border, section(0), section(1));
+                continue;
+            }
+
+            const qreal dash = (d->borderStyle == Qt::DotLine ? DOT_LENGTH : DASH_LENGTH) * width;
+            const qreal period = 2 * dash;
+            for (qreal dashStart = qFloor(start / period) * period; dashStart < sideLength; dashStart += period) {
+                const qreal from = qMax(dashStart, start);
+                const qreal to = qMin(dashStart + dash, sideLength);
+                if (from < to) {
+                    appendBorderSections(border, section((from - start) / length), section((to - start) / length));
+                }
             }
-        }
-    } else {
-        if (d->backgroundColor.isValid() && d->backgroundColor.alpha() != 0) {
-            QPainterPath path;
-            path.addRoundedRect(area, d->borderRadius, d->borderRadius);
-            painter->fillPath(path, d->backgroundColor);
         }
     }
+    setVertices(node->border, border);
+
+    return node;
 }
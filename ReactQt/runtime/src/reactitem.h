@@ -14,11 +14,11 @@
 #ifndef REACTITEM_H
 #define REACTITEM_H
 
-#include <QQuickPaintedItem>
+#include <QQuickItem>
 #include <QScopedPointer>
 
 class ReactItemPrivate;
-class ReactItem : public QQuickPaintedItem {
+class ReactItem : public QQuickItem {
     Q_OBJECT
     Q_PROPERTY(QString p_backfaceVisibility READ backfaceVisibility WRITE setBackfaceVisibility NOTIFY
                    backfaceVisibilityChanged)
@@ -161,7 +161,8 @@ Q_SIGNALS:
     void transformChanged();
 
 protected:
-    void paint(QPainter* painter);
+    void geometryChanged(const QRectF& newGeometry, const QRectF& oldGeometry) override;
+    QSGNode* updatePaintNode(QSGNode* oldNode, UpdatePaintNodeData* data) override;
 
 private:
     QScopedPointer<ReactItemPrivate> d_ptr;
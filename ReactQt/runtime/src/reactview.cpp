@@ -0,0 +1,91 @@
+
+/**
+ * Copyright (c) 2017-present, Status Research and Development GmbH.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "reactview.h"
+#include "utilities.h"
+
+class ReactViewPrivate {
+public:
+    Flexbox* flexbox = nullptr;
+    QString pointerEvents = "auto";
+    QVector<float> transformMatrix;
+};
+
+ReactView::ReactView(QQuickItem* parent) : ReactItem(parent), d_ptr(new ReactViewPrivate) {
+    Q_D(ReactView);
+    d->flexbox = new Flexbox(this);
+    d->flexbox->setControl(this);
+}
+
+ReactView::~ReactView() {}
+
+QObject* ReactView::viewManager() const {
+    return d_func()->flexbox->viewManager();
+}
+
+void ReactView::setViewManager(QObject* viewManager) {
+    Q_D(ReactView);
+    if (d->flexbox->viewManager() == viewManager)
+        return;
+    d->flexbox->setViewManager(viewManager);
+    Q_EMIT viewManagerChanged();
+}
+
+Flexbox* ReactView::flexbox() const {
+    return d_func()->flexbox;
+}
+
+QString ReactView::nativeID() const {
+    return objectName();
+}
+
+void ReactView::setNativeID(const QString& nativeID) {
+    if (objectName() == nativeID)
+        return;
+    setObjectName(nativeID);
+    Q_EMIT nativeIDChanged();
+}
+
+int ReactView::zIndex() const {
+    return z();
+}
+
+void ReactView::setZIndex(int zIndex) {
+    if (z() == zIndex)
+        return;
+    setZ(zIndex);
+    Q_EMIT zIndexChanged();
+}
+
+QString ReactView::pointerEvents() const {
+    return d_func()->pointerEvents;
+}
+
+void ReactView::setPointerEvents(const QString& pointerEvents) {
+    Q_D(ReactView);
+    if (d->pointerEvents == pointerEvents)
+        return;
+    d->pointerEvents = pointerEvents;
+    Q_EMIT pointerEventsChanged();
+}
+
+QVector<float> ReactView::transformMatrix() const {
+    return d_func()->transformMatrix;
+}
+
+void ReactView::setTransformMatrix(const QVector<float>& transformMatrix) {
+    Q_D(ReactView);
+    if (d->transformMatrix == transformMatrix)
+        return;
+    d->transformMatrix = transformMatrix;
+    utilities::setItemTransform(this, transformMatrix);
+    Q_EMIT transformMatrixChanged();
+}
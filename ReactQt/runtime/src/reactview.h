@@ -0,0 +1,69 @@
+
+/**
+ * Copyright (c) 2017-present, Status Research and Development GmbH.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#ifndef REACTVIEW_H
+#define REACTVIEW_H
+
+#include <QScopedPointer>
+#include <QString>
+#include <QVector>
+
+#include "layout/flexbox.h"
+#include "reactitem.h"
+
+// Native counterpart of RN View. Created directly by ViewManager, without a QML component
+class ReactViewPrivate;
+class ReactView : public ReactItem {
+    Q_OBJECT
+    Q_PROPERTY(QObject* viewManager READ viewManager WRITE setViewManager NOTIFY viewManagerChanged)
+    Q_PROPERTY(Flexbox* flexbox READ flexbox CONSTANT)
+    Q_PROPERTY(QString p_nativeID READ nativeID WRITE setNativeID NOTIFY nativeIDChanged)
+    Q_PROPERTY(int p_zIndex READ zIndex WRITE setZIndex NOTIFY zIndexChanged)
+    Q_PROPERTY(QString p_pointerEvents READ pointerEvents WRITE setPointerEvents NOTIFY pointerEventsChanged)
+    Q_PROPERTY(QVector<float> p_transformMatrix READ transformMatrix WRITE setTransformMatrix NOTIFY
+                   transformMatrixChanged)
+
+    Q_DECLARE_PRIVATE(ReactView)
+
+public:
+    ReactView(QQuickItem* parent = 0);
+    ~ReactView();
+
+    QObject* viewManager() const;
+    void setViewManager(QObject* viewManager);
+
+    Flexbox* flexbox() const;
+
+    QString nativeID() const;
+    void setNativeID(const QString& nativeID);
+
+    int zIndex() const;
+    void setZIndex(int zIndex);
+
+    QString pointerEvents() const;
+    void setPointerEvents(const QString& pointerEvents);
+
+    // Older form of transform, sets the same MatrixTransform
+    QVector<float> transformMatrix() const;
+    void setTransformMatrix(const QVector<float>& transformMatrix);
+
+Q_SIGNALS:
+    void viewManagerChanged();
+    void nativeIDChanged();
+    void zIndexChanged();
+    void pointerEventsChanged();
+    void transformMatrixChanged();
+
+private:
+    QScopedPointer<ReactViewPrivate> d_ptr;
+};
+
+#endif // REACTVIEW_H
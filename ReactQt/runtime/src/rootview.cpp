@@ -12,7 +12,9 @@
  */
 
 #include <QGuiApplication>
+#include <QPointer>
 #include <QQmlEngine>
+#include <QQuickWindow>
 #include <QScreen>
 #include <QTimer>
 #include <QVariant>
@@ -50,6 +52,11 @@ public:
     QString pluginsPath;
     QString jsExecutor = "NodeJsExecutor"; // "JSWebEngineExecutor";
     QString serverConnectionType = "RemoteServerConnection";
+    int viewIncubationBudget = 0;
+    bool asynchronousLayout = true;
+    bool layoutRequested = false;
+    QSizeF layoutSize;
+    QPointer<QQuickWindow> frameWindow;
     Bridge* bridge = nullptr;
     RootView* q_ptr;
     bool remoteJSDebugging = false;
@@ -113,6 +120,8 @@ RootView::RootView(QQuickItem* parent) : ReactItem(parent), d_ptr(new RootViewPr
     connect(this, SIGNAL(widthChanged()), this, SLOT(onSizeChanged()));
     connect(this, SIGNAL(heightChanged()), this, SLOT(onSizeChanged()));
     connect(this, SIGNAL(scaleChanged()), this, SLOT(onSizeChanged()));
+
+    connect(this, &QQuickItem::windowChanged, this, &RootView::onWindowChanged);
 }
 
 RootView::~RootView() {}
@@ -228,6 +237,57 @@ void RootView::setExternalModules(const QVariantList& externalModules) {
     Q_EMIT externalModulesChanged();
 }
 
+int RootView::viewIncubationBudget() const {
+    return d_func()->viewIncubationBudget;
+}
+
+void RootView::setViewIncubationBudget(int viewIncubationBudget) {
+    Q_D(RootView);
+    if (d->viewIncubationBudget == viewIncubationBudget)
+        return;
+    d->viewIncubationBudget = viewIncubationBudget;
+    if (d->bridge) {
+        d->bridge->setViewIncubationBudget(viewIncubationBudget);
+    }
+    Q_EMIT viewIncubationBudgetChanged();
+}
+
+bool RootView::asynchronousLayout() const {
+    return d_func()->asynchronousLayout;
+}
+
+void RootView::setAsynchronousLayout(bool asynchronousLayout) {
+    Q_D(RootView);
+    if (d->asynchronousLayout == asynchronousLayout)
+        return;
+    d->asynchronousLayout = asynchronousLayout;
+    Q_EMIT asynchronousLayoutChanged();
+}
+
+QStringList RootView::yogaExperimentalFeatures() const {
+    return d_func()->bridge->yogaExperimentalFeatures();
+}
+
+void RootView::setYogaExperimentalFeatures(const QStringList& yogaExperimentalFeatures) {
+    Q_D(RootView);
+    if (d->bridge->yogaExperimentalFeatures() == yogaExperimentalFeatures)
+        return;
+    d->bridge->setYogaExperimentalFeatures(yogaExperimentalFeatures);
+    Q_EMIT yogaExperimentalFeaturesChanged();
+}
+
+bool RootView::yogaUseWebDefaults() const {
+    return d_func()->bridge->yogaUseWebDefaults();
+}
+
+void RootView::setYogaUseWebDefaults(bool yogaUseWebDefaults) {
+    Q_D(RootView);
+    if (d->bridge->yogaUseWebDefaults() == yogaUseWebDefaults)
+        return;
+    d->bridge->setYogaUseWebDefaults(yogaUseWebDefaults);
+    Q_EMIT yogaUseWebDefaultsChanged();
+}
+
 Bridge* RootView::bridge() const {
     return d_func()->bridge;
 }
@@ -259,14 +319,62 @@ void RootView::reloadBridge() {
 }
 
 void RootView::recalculateLayout() {
+    Q_D(RootView);
+
+    // All requests until the next frame are coalesced into one pass
+    if (d->layoutRequested)
+        return;
+    d->layoutRequested = true;
+
+    if (d->frameWindow && d->frameWindow->isExposed()) {
+        d->frameWindow->update();
+    } else {
+        QTimer::singleShot(0, this, &RootView::performLayout);
+    }
+}
+
+void RootView::invalidateLayout() {
     if (childItems().count() == 1) {
-        auto view = childItems().at(0);
-        Flexbox* flexbox = Flexbox::findFlexbox(view);
-        if (flexbox) {
-            flexbox->recalculateLayout(width(), height());
-            // flexbox->printFlexboxHierarchy();
+        if (Flexbox* flexbox = Flexbox::findFlexbox(childItems().at(0))) {
+            flexbox->markSubtreeDirty();
         }
     }
+    recalculateLayout();
+}
+
+void RootView::performLayout() {
+    Q_D(RootView);
+
+    if (!d->layoutRequested)
+        return;
+
+    Flexbox* flexbox = childItems().count() == 1 ? Flexbox::findFlexbox(childItems().at(0)) : nullptr;
+    // The pass in flight requests the next one from onLayoutCommitted()
+    if (flexbox && flexbox->isLayoutInFlight())
+        return;
+    d->layoutRequested = false;
+
+    emit aboutToLayout();
+
+    if (!flexbox)
+        return;
+
+    const QSizeF size(width(), height());
+    if (size == d->layoutSize && !flexbox->isDirty())
+        return;
+    d->layoutSize = size;
+
+    if (d->asynchronousLayout) {
+        QPointer<RootView> self(this);
+        flexbox->recalculateLayoutAsync(width(), height(), [self]() {
+            if (self) {
+                self->onLayoutCommitted();
+            }
+        });
+    } else {
+        flexbox->recalculateLayout(width(), height());
+    }
+    // flexbox->printFlexboxHierarchy();
 }
 
 void RootView::bridgeReady() {
@@ -294,6 +402,40 @@ void RootView::onSizeChanged() {
     recalculateLayout();
 }
 
+void RootView::onLayoutCommitted() {
+    Q_D(RootView);
+
+    // Changes made during the pass may have invalidated the committed layout
+    Flexbox* flexbox = childItems().count() == 1 ? Flexbox::findFlexbox(childItems().at(0)) : nullptr;
+    if (d->layoutRequested || (flexbox && flexbox->isDirty())) {
+        d->layoutRequested = false;
+        recalculateLayout();
+    }
+}
+
+void RootView::onWindowChanged(QQuickWindow* window) {
+    Q_D(RootView);
+
+    if (d->frameWindow) {
+        disconnect(d->frameWindow, &QQuickWindow::afterAnimating, this, &RootView::performLayout);
+        disconnect(d->frameWindow, &QWindow::screenChanged, this, &RootView::updatePointScaleFactor);
+    }
+    d->frameWindow = window;
+    if (window) {
+        // Emitted on the GUI thread once per frame, before the scene graph is synchronized
+        connect(window, &QQuickWindow::afterAnimating, this, &RootView::performLayout);
+        connect(window, &QWindow::screenChanged, this, &RootView::updatePointScaleFactor);
+        updatePointScaleFactor();
+    }
+}
+
+void RootView::updatePointScaleFactor() {
+    Q_D(RootView);
+    if (d->frameWindow) {
+        d->bridge->setPointScaleFactor(d->frameWindow->effectiveDevicePixelRatio());
+    }
+}
+
 void RootView::sendSizeUpdate() {
     Q_D(RootView);
     if (!d->bridge->ready())
@@ -330,6 +472,7 @@ void RootView::componentComplete() {
         d->bridge->setPluginsPath(d->pluginsPath);
         d->bridge->setJsExecutor(d->jsExecutor);
         d->bridge->setServerConnectionType(d->serverConnectionType);
+        d->bridge->setViewIncubationBudget(d->viewIncubationBudget);
         d->bridge->setVisualParent(this);
         d->bridge->init();
     });
@@ -36,6 +36,14 @@ class RootView : public ReactItem {
     Q_PROPERTY(
         QString serverConnectionType READ serverConnectionType WRITE setServerConnectionType NOTIFY executorChanged)
     Q_PROPERTY(QVariantList externalModules READ externalModules WRITE setExternalModules NOTIFY externalModulesChanged)
+    Q_PROPERTY(int viewIncubationBudget READ viewIncubationBudget WRITE setViewIncubationBudget NOTIFY
+                   viewIncubationBudgetChanged)
+    Q_PROPERTY(bool asynchronousLayout READ asynchronousLayout WRITE setAsynchronousLayout NOTIFY
+                   asynchronousLayoutChanged)
+    Q_PROPERTY(QStringList yogaExperimentalFeatures READ yogaExperimentalFeatures WRITE setYogaExperimentalFeatures
+                   NOTIFY yogaExperimentalFeaturesChanged)
+    Q_PROPERTY(bool yogaUseWebDefaults READ yogaUseWebDefaults WRITE setYogaUseWebDefaults NOTIFY
+                   yogaUseWebDefaultsChanged)
 
     Q_DECLARE_PRIVATE(RootView)
 
@@ -70,11 +78,27 @@ public:
     QVariantList externalModules() const;
     void setExternalModules(const QVariantList& externalModules);
 
+    int viewIncubationBudget() const;
+    void setViewIncubationBudget(int viewIncubationBudget);
+
+    bool asynchronousLayout() const;
+    void setAsynchronousLayout(bool asynchronousLayout);
+
+    QStringList yogaExperimentalFeatures() const;
+    void setYogaExperimentalFeatures(const QStringList& yogaExperimentalFeatures);
+
+    bool yogaUseWebDefaults() const;
+    void setYogaUseWebDefaults(bool yogaUseWebDefaults);
+
     Bridge* bridge() const;
 
     void loadBundle(const QString& moduleName, const QUrl& codeLocation);
 
+    // Schedules a layout pass for the next frame, which only runs if the
+    // size changed or some Yoga node of the tree is dirty
     void recalculateLayout();
+    // Like recalculateLayout(), but none of the cached layout is reused
+    void invalidateLayout();
     Q_INVOKABLE void startRemoteJSDebugging();
     Q_INVOKABLE void reloadBridge();
 
@@ -88,11 +112,21 @@ Q_SIGNALS:
     void executorChanged();
     void externalModulesChanged();
     void jsExecutorChanged();
+    void viewIncubationBudgetChanged();
+    void asynchronousLayoutChanged();
+    void yogaExperimentalFeaturesChanged();
+    void yogaUseWebDefaultsChanged();
+    // Emitted before a layout pass, so views can flush changes they batched up
+    void aboutToLayout();
 
 private Q_SLOTS:
     void bridgeReady();
     void onSizeChanged();
     void sendSizeUpdate();
+    void onLayoutCommitted();
+    void onWindowChanged(QQuickWindow* window);
+    void updatePointScaleFactor();
+    void performLayout();
 
 private:
     void componentComplete() override;
@@ -17,10 +17,26 @@
 #include <QNetworkReply>
 #include <QNetworkRequest>
 
+#include <cmath>
+
 #include "bridge.h"
 #include "timing.h"
 
-Timing::Timing(QObject* parent) : QObject(parent) {}
+namespace {
+// Timers fire on frame ticks, all timers due in a frame are sent to js in one call
+const double FRAME_DURATION = 1000.0 / 60;
+// Intervals shorter than about a frame run each frame
+const int MIN_INTERVAL = 18;
+// Idle callbacks are only called with at least this much of the frame left, in msecs
+const double IDLE_CALLBACK_FRAME_DEADLINE = 1;
+} // namespace
+
+Timing::Timing(QObject* parent) : QObject(parent) {
+    m_clock.start();
+    m_tickTimer.setSingleShot(true);
+    m_tickTimer.setTimerType(Qt::PreciseTimer);
+    connect(&m_tickTimer, &QTimer::timeout, this, &Timing::tick);
+}
 
 Timing::~Timing() {}
 
@@ -36,12 +52,19 @@ QString Timing::moduleName() {
     return "RCTTiming";
 }
 
-void Timing::callTimer(const int timerId) {
+void Timing::callJsTimers(const QString& method, const QVariantList& args) {
     if (m_bridge) {
-        QVariantList args;
-        QVariantList timersArray{timerId};
-        args.push_back(timersArray);
-        m_bridge->enqueueJSCall("JSTimers", "callTimers", args);
+        m_bridge->enqueueJSCall("JSTimers", method, args);
+    }
+}
+
+bool Timing::isJsIdle() const {
+    return m_bridge && m_bridge->jsCallsInFlight() == 0;
+}
+
+void Timing::callTimers(const QVariantList& timerIds) {
+    if (!timerIds.isEmpty()) {
+        callJsTimers("callTimers", QVariantList{QVariant(timerIds)});
     }
 }
 
@@ -65,43 +88,118 @@ void Timing::callTimer(const int timerId) {
  Notes:
   - requestAnimationFrame asks for a callback after duration 1ms, this
     effectively means it will served on the next frame refresh
-  - This version; maybe the view, or some part, should be a custom node in the
-    scene graph to properly sync (especially re: animations)
+  - This version ticks on a 60hz grid of its own rather than on the frames
+    of a window, so an idle app doesn't wake up each frame. Only the tick the
+    earliest timer is due in is armed.
 */
 
 void Timing::createTimer(int timerId, int duration /*ms*/, const QDateTime& jsSchedulingTime, bool repeats) {
+    deleteTimer(timerId);
 
     if (duration == 0 && !repeats) {
-        // XXX: enqueueJSCall should enqueue
-        QTimer::singleShot(0, [=] { callTimer(timerId); });
+        // All of the immediate timers of a batch of calls from js go back in one call
+        if (m_immediateTimers.isEmpty()) {
+            QTimer::singleShot(0, this, &Timing::callImmediateTimers);
+        }
+        m_immediateTimers.push_back(timerId);
         return;
     }
 
-    QTimer* timer = new QTimer(this);
-    timer->setTimerType(Qt::PreciseTimer);
-    timer->setSingleShot(!repeats);
-
-    QObject::connect(timer, &QTimer::timeout, this, [=]() {
-        callTimer(timerId);
-        if (!repeats)
-            deleteTimer(timerId);
-    });
-    m_activeTimers[timerId] = timer;
-    if (duration < 18) {
-        // XXX: mimicking RN behavior via timeouts
-        timer->start((1.0 / 60) * 1000);
-    } else {
-        timer->start(duration);
-    }
+    // Time the call took to get here is taken off the first interval
+    const qint64 schedulingOverhead =
+        jsSchedulingTime.isValid() ? qBound<qint64>(0, jsSchedulingTime.msecsTo(QDateTime::currentDateTime()), duration)
+                                   : 0;
+
+    Timer timer;
+    timer.target = m_clock.elapsed() + duration - schedulingOverhead;
+    timer.interval = duration < MIN_INTERVAL ? 0 : duration;
+    timer.repeats = repeats;
+    m_timers.insert(timerId, timer);
+    m_timerQueue.insert(qMakePair(timer.target, timerId), timerId);
+
+    scheduleTick();
 }
 
 void Timing::deleteTimer(int timerId) {
-    // qDebug() << __PRETTY_FUNCTION__ << timerId;
-    QMap<int, QTimer*>::iterator it = m_activeTimers.find(timerId);
-    if (it == m_activeTimers.end())
+    auto it = m_timers.find(timerId);
+    if (it == m_timers.end()) {
+        m_immediateTimers.removeOne(timerId);
         return;
+    }
+
+    // The tick stays armed, it is cheap when nothing is due
+    m_timerQueue.remove(qMakePair(it->target, timerId));
+    m_timers.erase(it);
+}
+
+void Timing::setSendIdleEvents(bool sendIdleEvents) {
+    m_sendIdleEvents = sendIdleEvents;
+    if (sendIdleEvents) {
+        scheduleTick();
+    }
+}
+
+void Timing::callImmediateTimers() {
+    QVariantList timerIds;
+    timerIds.swap(m_immediateTimers);
+    callTimers(timerIds);
+}
+
+void Timing::scheduleTick() {
+    const qint64 now = m_clock.elapsed();
+    qint64 due = -1;
+    if (!m_timerQueue.isEmpty()) {
+        due = qMax(m_timerQueue.firstKey().first, now);
+    }
+    // Idle callbacks are offered each frame while js has any
+    if (m_sendIdleEvents) {
+        due = now;
+    }
+    if (due == -1)
+        return;
+
+    // First frame starting once the timer is due, a tick is never armed for the frame it runs in
+    double frame = std::ceil(due / FRAME_DURATION);
+    if (frame * FRAME_DURATION <= now) {
+        frame += 1;
+    }
+    const int delay = int(std::ceil(frame * FRAME_DURATION)) - now;
+    if (!m_tickTimer.isActive() || m_tickTimer.remainingTime() > delay) {
+        m_tickTimer.start(delay);
+    }
+}
+
+void Timing::tick() {
+    const qint64 now = m_clock.elapsed();
+
+    QVariantList timerIds;
+    while (!m_timerQueue.isEmpty() && m_timerQueue.firstKey().first <= now) {
+        timerIds.push_back(m_timerQueue.take(m_timerQueue.firstKey()));
+    }
+
+    // Rescheduled after all due timers are taken, intervals of 0 fire again in the next frame
+    for (const QVariant& timerId : timerIds) {
+        auto timer = m_timers.find(timerId.toInt());
+        if (timer->repeats) {
+            timer->target = now + timer->interval;
+            m_timerQueue.insert(qMakePair(timer->target, timer.key()), timer.key());
+        } else {
+            m_timers.erase(timer);
+        }
+    }
+
+    // Idle callbacks wait for a frame without due timers
+    const bool jsIdle = timerIds.isEmpty() && isJsIdle();
+    callTimers(timerIds);
+
+    if (m_sendIdleEvents && jsIdle) {
+        // Js measures the time left against the start of the frame, in msecs since the epoch as Date.now()
+        const double frameElapsed = std::fmod(double(now), FRAME_DURATION);
+        if (FRAME_DURATION - frameElapsed >= IDLE_CALLBACK_FRAME_DEADLINE) {
+            const double frameStart = QDateTime::currentMSecsSinceEpoch() - frameElapsed;
+            callJsTimers("callIdleCallbacks", QVariantList{frameStart});
+        }
+    }
 
-    (*it)->stop();
-    (*it)->deleteLater();
-    m_activeTimers.erase(it);
+    scheduleTick();
 }
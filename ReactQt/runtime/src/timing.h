@@ -14,6 +14,8 @@
 #ifndef TIMING_H
 #define TIMING_H
 
+#include <QElapsedTimer>
+#include <QHash>
 #include <QMap>
 #include <QObject>
 #include <QPointer>
@@ -31,6 +33,7 @@ class Timing : public QObject, public ModuleInterface {
 
     Q_INVOKABLE void createTimer(int callbackId, int duration, const QDateTime& jsSchedulingTime, bool repeats);
     Q_INVOKABLE void deleteTimer(int timerId);
+    Q_INVOKABLE void setSendIdleEvents(bool sendIdleEvents);
 
 public:
     Timing(QObject* parent = 0);
@@ -43,12 +46,37 @@ public:
 
     QString moduleName() override;
 
+protected:
+    // Js side of the module, tests stand in for the bridge by overriding these
+    virtual void callJsTimers(const QString& method, const QVariantList& args);
+    // Js is idle when it has returned from everything sent to it so far
+    virtual bool isJsIdle() const;
+
+private Q_SLOTS:
+    void callImmediateTimers();
+    void tick();
+
 private:
-    void callTimer(const int timerId);
+    struct Timer {
+        qint64 target;
+        qint64 interval;
+        bool repeats;
+    };
+
+    void scheduleTick();
+    void callTimers(const QVariantList& timerIds);
 
 private:
     QPointer<Bridge> m_bridge;
-    QMap<int, QTimer*> m_activeTimers;
+    // Timers by id, and their ids ordered by the time they are due on m_clock. Js allocates ids in order,
+    // so timers due at the same time fire in the order they were created.
+    QHash<int, Timer> m_timers;
+    QMap<QPair<qint64, int>, int> m_timerQueue;
+    QVariantList m_immediateTimers;
+    // Single shot, armed for the frame the earliest timer is due in
+    QTimer m_tickTimer;
+    QElapsedTimer m_clock;
+    bool m_sendIdleEvents = false;
 };
 
 #endif // TIMING_H
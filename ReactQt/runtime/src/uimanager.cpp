@@ -28,6 +28,7 @@
 #include "componentdata.h"
 #include "componentmanagers/scrollviewmanager.h"
 #include "componentmanagers/viewmanager.h"
+#include "incubationcontroller.h"
 #include "layout/flexbox.h"
 #include "moduledata.h"
 #include "modulemethod.h"
@@ -41,6 +42,9 @@ Q_LOGGING_CATEGORY(UIMANAGER, "UIManager")
 int UIManager::m_nextRootTag = 1;
 
 void UIManager::removeSubviewsFromContainerWithID(int containerReactTag) {
+    if (deferWhileIncubating([=] { removeSubviewsFromContainerWithID(containerReactTag); }))
+        return;
+
     QQuickItem* item = m_views.value(containerReactTag);
     if (item == nullptr) {
         qCWarning(UIMANAGER) << __PRETTY_FUNCTION__ << "Attempting to access unknown view";
@@ -55,6 +59,9 @@ void UIManager::removeSubviewsFromContainerWithID(int containerReactTag) {
 }
 
 void UIManager::measure(int reactTag, const ModuleInterface::ListArgumentBlock& callback) {
+    if (deferWhileIncubating([=] { measure(reactTag, callback); }))
+        return;
+
     QQuickItem* item = m_views.value(reactTag);
     if (item == nullptr) {
         qCWarning(UIMANAGER) << "Attempting to access unknown view";
@@ -77,6 +84,9 @@ void UIManager::measure(int reactTag, const ModuleInterface::ListArgumentBlock&
 }
 
 void UIManager::measureInWindow(int reactTag, const ModuleInterface::ListArgumentBlock& callback) {
+    if (deferWhileIncubating([=] { measureInWindow(reactTag, callback); }))
+        return;
+
     QQuickItem* item = m_views.value(reactTag);
     if (item == nullptr) {
         qCWarning(UIMANAGER) << "Attempting to access unknown view";
@@ -91,6 +101,9 @@ void UIManager::measureInWindow(int reactTag, const ModuleInterface::ListArgumen
 }
 
 void UIManager::updateView(int reactTag, const QString& viewName, const QVariantMap& properties) {
+    if (deferWhileIncubating([=] { updateView(reactTag, viewName, properties); }))
+        return;
+
     QQuickItem* item = m_views.value(reactTag);
     if (item == nullptr) {
         qCWarning(UIMANAGER) << "Attempting to update properties on unknown view; reactTag=" << reactTag
@@ -103,6 +116,9 @@ void UIManager::updateView(int reactTag, const QString& viewName, const QVariant
 }
 
 void UIManager::setChildren(int containerReactTag, const QList<int>& childrenTags) {
+    if (deferWhileIncubating([=] { setChildren(containerReactTag, childrenTags); }))
+        return;
+
     // TODO: This is a simple implementation which fixes a broken example. It's not properly tested and may need
     // revisiting
     QList<int> indices;
@@ -112,22 +128,19 @@ void UIManager::setChildren(int containerReactTag, const QList<int>& childrenTag
     manageChildren(containerReactTag, QList<int>(), QList<int>(), childrenTags, indices, QList<int>());
 }
 
-QList<QQuickItem*> UIManager::removeChildrenFromVisualParent(QQuickItem* parent, const QList<int>& removeAtIndices) {
+QList<QQuickItem*> UIManager::removeChildrenFromVisualParent(QQuickItem* parent,
+                                                             const QList<int>& removeAtIndices,
+                                                             bool removeFlexboxChilds) {
 
     Q_ASSERT(parent != nullptr);
 
     QList<QQuickItem*> itemsToRemove;
     if (!removeAtIndices.isEmpty()) {
+        itemsToRemove = utilities::takeChildItemsAt(parent, removeAtIndices);
 
-        for (int i : removeAtIndices) {
-            itemsToRemove.push_back(parent->childItems().at(i));
+        if (removeFlexboxChilds) {
+            utilities::removeFlexboxChilds(parent, removeAtIndices);
         }
-
-        for (QQuickItem* child : itemsToRemove) {
-            child->setParentItem(nullptr);
-        }
-
-        utilities::removeFlexboxChilds(parent, removeAtIndices);
     }
     return itemsToRemove;
 }
@@ -136,6 +149,38 @@ void UIManager::destroyComponents(const QList<QQuickItem*> itemsToDestroy) {
     for (QQuickItem* item : itemsToDestroy) {
         item->setParent(nullptr);
         stopTrackingTagsForHierarchy(item);
+        recycleOrDestroy(item);
+    }
+}
+
+void UIManager::recycleOrDestroy(QQuickItem* item) {
+    AttachedProperties* ap = AttachedProperties::get(item, false);
+    ViewManager* vm = ap ? ap->viewManager() : nullptr;
+    if (vm == nullptr || !vm->canRecycleView(item)) {
+        item->deleteLater();
+        return;
+    }
+
+    // Pooled views must not carry their old react children, detach them and give each one
+    // the same chance to be reused
+    QList<int> childIndices;
+    const QList<QQuickItem*> childItems = item->childItems();
+    for (int i = 0; i < childItems.size(); ++i) {
+        if (AttachedProperties::get(childItems[i], false)) {
+            childIndices.push_back(i);
+        }
+    }
+    // Non react items, like the content item of a scroll view, are interleaved with the react children,
+    // so their indices don't address Yoga children. Yoga nodes are detached one by one instead.
+    for (QQuickItem* child : removeChildrenFromVisualParent(item, childIndices, false)) {
+        if (Flexbox* childFlexbox = Flexbox::findFlexbox(child)) {
+            childFlexbox->removeFromParent();
+        }
+        child->setParent(nullptr);
+        recycleOrDestroy(child);
+    }
+
+    if (!vm->recycleView(item)) {
         item->deleteLater();
     }
 }
@@ -161,8 +206,13 @@ void UIManager::manageChildren(int containerReactTag,
                                const QList<int>& addChildReactTags,
                                const QList<int>& addAtIndices,
                                const QList<int>& removeAtIndices) {
+    if (deferWhileIncubating([=] {
+            manageChildren(
+                containerReactTag, moveFromIndicies, moveToIndices, addChildReactTags, addAtIndices, removeAtIndices);
+        }))
+        return;
 
-    QQuickItem* container = m_views[containerReactTag];
+    QQuickItem* container = m_views.value(containerReactTag);
     if (container == nullptr) {
         qCWarning(UIMANAGER) << "Attempting to manage children on an unknown container";
         return;
@@ -179,11 +229,25 @@ void UIManager::manageChildren(int containerReactTag,
     Q_ASSERT(moveFromIndicies.size() == moveToIndices.size());
     Q_ASSERT(addChildReactTags.size() == addAtIndices.size());
 
+    // Yoga children are updated with a single diff once the visual hierarchy is done. Moved items are
+    // looked up after the removal, so their indices are mapped back to the indices before it.
+    QList<int> flexboxRemoveAtIndices = removeAtIndices;
+    QList<int> sortedRemoveAtIndices = removeAtIndices;
+    std::sort(sortedRemoveAtIndices.begin(), sortedRemoveAtIndices.end());
+    for (int index : moveFromIndicies) {
+        for (int removedIndex : sortedRemoveAtIndices) {
+            if (removedIndex > index)
+                break;
+            ++index;
+        }
+        flexboxRemoveAtIndices.append(index);
+    }
+
     QList<QQuickItem*> toDestroy;
     if (ScrollViewManager::isArrayScrollingOptimizationEnabled(container)) {
-        toDestroy = ScrollViewManager::removeListViewItems(container, removeAtIndices);
+        toDestroy = ScrollViewManager::removeListViewItems(container, removeAtIndices, false);
     } else {
-        toDestroy = removeChildrenFromVisualParent(container, removeAtIndices);
+        toDestroy = removeChildrenFromVisualParent(container, removeAtIndices, false);
     }
     destroyComponents(toDestroy);
 
@@ -201,7 +265,7 @@ void UIManager::manageChildren(int containerReactTag,
             itemToMove = container->childItems().at(indexToMoveFrom);
         }
 
-        int itemTagToMove = m_views.key(itemToMove, -1);
+        int itemTagToMove = m_views.tag(itemToMove);
         Q_ASSERT(itemTagToMove != -1);
 
         allTargetIndices.append(indexToMoveTo);
@@ -211,9 +275,9 @@ void UIManager::manageChildren(int containerReactTag,
 
     if (!moveFromIndicies.isEmpty()) {
         if (ScrollViewManager::isArrayScrollingOptimizationEnabled(container)) {
-            ScrollViewManager::removeListViewItems(container, moveFromIndicies);
+            ScrollViewManager::removeListViewItems(container, moveFromIndicies, false);
         } else {
-            removeChildrenFromVisualParent(container, moveFromIndicies);
+            removeChildrenFromVisualParent(container, moveFromIndicies, false);
         }
     }
 
@@ -222,40 +286,48 @@ void UIManager::manageChildren(int containerReactTag,
     std::transform(
         allTags.begin(), allTags.end(), std::back_inserter(children), [this](int key) { return m_views.value(key); });
 
+    QList<int> flexboxAddAtIndices;
+    QList<Flexbox*> flexboxChildren;
+    Flexbox* containerFlexbox = Flexbox::findFlexbox(container);
+
     if (children.size() > 0) {
         // on iOS, order of the subviews implies z-order, implicitly its the same in
         // QML, barring some exceptions. revisit - set zorder appears to be the only
         // exception can probably self order items, but it's not an explicit guarantee
+        ViewManager* vm = AttachedProperties::get(container)->viewManager();
+        if (ScrollViewManager::isArrayScrollingOptimizationEnabled(container)) {
+            ScrollViewManager::insertListViewItems(container, children, allTargetIndices);
+        } else if (vm != nullptr) {
+            // Add to visual hierarchy in one batch, appended children don't need to be restacked
+            vm->addChildItems(container, children, allTargetIndices);
+        } else {
+            utilities::insertChildItemsAt(children, allTargetIndices, container);
+        }
+
         QList<QQuickItem*>::iterator it = children.begin();
         for (int i : allTargetIndices) {
             QQuickItem* child = *it++;
 
-            // Add to visual hierarchy
-            ViewManager* vm = AttachedProperties::get(container)->viewManager();
-            if (vm != nullptr) {
-                if (ScrollViewManager::isArrayScrollingOptimizationEnabled(container)) {
-                    ScrollViewManager::updateListViewItem(container, child, i);
-                } else {
-                    vm->addChildItem(container, child, i);
-                }
-
-            } else {
-                utilities::insertChildItemAt(child, i, container);
-            }
-
-            auto containerFlexbox = Flexbox::findFlexbox(container);
             auto childFlexbox = Flexbox::findFlexbox(child);
             if (containerFlexbox && childFlexbox) {
-                qCDebug(UIMANAGER) << "::manageChildren containerFlexbox->addChild Parent container: " << container
+                qCDebug(UIMANAGER) << "::manageChildren adding flexbox child, parent container: " << container
                                    << " parent container flexbox: " << containerFlexbox << " Child item: " << child
                                    << " child flexbox: " << childFlexbox << " position to add at: " << i;
-                containerFlexbox->addChild(i, childFlexbox);
+                flexboxAddAtIndices.append(i);
+                flexboxChildren.append(childFlexbox);
             }
         }
     }
+
+    if (containerFlexbox) {
+        containerFlexbox->updateChildren(flexboxRemoveAtIndices, flexboxAddAtIndices, flexboxChildren);
+    }
 }
 
 void UIManager::replaceExistingNonRootView(int reactTag, int newReactTag) {
+    if (deferWhileIncubating([=] { replaceExistingNonRootView(reactTag, newReactTag); }))
+        return;
+
     QQuickItem* oldItem = m_views.value(reactTag);
     if (oldItem == nullptr) {
         qCCritical(UIMANAGER) << __PRETTY_FUNCTION__ << "Attempting to access unknown item";
@@ -281,6 +353,9 @@ void UIManager::measureLayout(int reactTag,
                               int ancestorReactTag,
                               const ModuleInterface::ListArgumentBlock& errorCallback,
                               const ModuleInterface::ListArgumentBlock& callback) {
+    if (deferWhileIncubating([=] { measureLayout(reactTag, ancestorReactTag, errorCallback, callback); }))
+        return;
+
     QQuickItem* item = m_views.value(reactTag);
     QQuickItem* ancestor = m_views.value(reactTag);
     Q_ASSERT(item != nullptr && ancestor != nullptr);
@@ -305,6 +380,9 @@ void UIManager::measureLayout(int reactTag,
 void UIManager::measureLayoutRelativeToParent(int reactTag,
                                               const ModuleInterface::ListArgumentBlock& errorCallback,
                                               const ModuleInterface::ListArgumentBlock& callback) {
+    if (deferWhileIncubating([=] { measureLayoutRelativeToParent(reactTag, errorCallback, callback); }))
+        return;
+
     QQuickItem* item = m_views.value(reactTag);
     Q_ASSERT(item != nullptr);
 
@@ -338,12 +416,37 @@ void UIManager::createView(int reactTag, const QString& viewName, int rootTag, c
         return;
     }
 
+    if (incubationAvailable()) {
+        const int generation = m_incubationGeneration;
+        m_incubatingTags.insert(reactTag);
+        cd->incubateView(reactTag, props, [=](QQuickItem* item) {
+            if (generation != m_incubationGeneration) {
+                // UIManager was reset while the view was incubating
+                if (item)
+                    item->deleteLater();
+                return;
+            }
+
+            m_incubatingTags.remove(reactTag);
+            if (item == nullptr) {
+                qCWarning(UIMANAGER) << "Failed to create view of type" << viewName;
+            } else {
+                registerView(reactTag, item, props);
+            }
+            flushDeferredOperations();
+        });
+        return;
+    }
+
     QQuickItem* item = cd->createView(reactTag, props);
     if (item == nullptr) {
         qCWarning(UIMANAGER) << "Failed to create view of type" << viewName;
         return;
     }
+    registerView(reactTag, item, props);
+}
 
+void UIManager::registerView(int reactTag, QQuickItem* item, const QVariantMap& props) {
     AttachedProperties* ap = AttachedProperties::get(item);
 
     // TODO: move to createView?
@@ -354,7 +457,59 @@ void UIManager::createView(int reactTag, const QString& viewName, int rootTag, c
     m_views.insert(reactTag, item);
 }
 
+bool UIManager::incubationAvailable() {
+    if (m_incubationBudget <= 0)
+        return false;
+
+    if (m_incubationController == nullptr) {
+        QQuickWindow* window = m_bridge->visualParent() ? m_bridge->visualParent()->window() : nullptr;
+        if (window == nullptr)
+            return false;
+        m_incubationController = new IncubationController(window, m_incubationBudget, this);
+        m_bridge->qmlEngine()->setIncubationController(m_incubationController);
+    }
+    return true;
+}
+
+bool UIManager::deferWhileIncubating(const std::function<void()>& operation) {
+    // Operations are queued in order as soon as any view is incubating, so that
+    // the ones which don't touch incubating views can't overtake the ones which do
+    if (m_incubatingTags.isEmpty())
+        return false;
+
+    m_deferredOperations.push_back(operation);
+    return true;
+}
+
+void UIManager::flushDeferredOperations() {
+    if (!m_incubatingTags.isEmpty() || m_deferredOperations.isEmpty())
+        return;
+
+    while (!m_deferredOperations.isEmpty() && m_incubatingTags.isEmpty()) {
+        m_deferredOperations.takeFirst()();
+    }
+
+    // The batch which queued these operations has already been laid out
+    if (m_bridge->visualParent()) {
+        m_bridge->visualParent()->recalculateLayout();
+    }
+}
+
+int UIManager::incubationBudget() const {
+    return m_incubationBudget;
+}
+
+void UIManager::setIncubationBudget(int msecs) {
+    m_incubationBudget = qMax(0, msecs);
+    if (m_incubationController) {
+        m_incubationController->setBudget(m_incubationBudget);
+    }
+}
+
 void UIManager::findSubviewIn(int reactTag, const QPointF& point, const ModuleInterface::ListArgumentBlock& callback) {
+    if (deferWhileIncubating([=] { findSubviewIn(reactTag, point, callback); }))
+        return;
+
     QQuickItem* item = m_views.value(reactTag);
     if (item == nullptr) {
         qCWarning(UIMANAGER) << "Attempting to access unknown view";
@@ -387,6 +542,9 @@ void UIManager::findSubviewIn(int reactTag, const QPointF& point, const ModuleIn
 }
 
 void UIManager::dispatchViewManagerCommand(int reactTag, int commandID, const QVariantList& commandArgs) {
+    if (deferWhileIncubating([=] { dispatchViewManagerCommand(reactTag, commandID, commandArgs); }))
+        return;
+
     QQuickItem* item = m_views.value(reactTag);
     if (item == nullptr) {
         qCWarning(UIMANAGER) << __PRETTY_FUNCTION__ << "Attempting to access unknown view";
@@ -464,16 +622,18 @@ UIManager::~UIManager() {
 }
 
 void UIManager::reset() {
+    ++m_incubationGeneration;
+    m_incubatingTags.clear();
+    m_deferredOperations.clear();
+
     // Avoid to delete root view on reset
     QQuickItem* rootView = nullptr;
     if (m_rootTag != -1 && m_views.contains(m_rootTag)) {
-        rootView = m_views[m_rootTag];
-        if (rootView) {
-            m_views.remove(m_rootTag);
-        }
+        rootView = m_views.value(m_rootTag);
+        m_views.remove(m_rootTag);
     }
 
-    for (auto& v : m_views) {
+    for (QQuickItem* v : m_views.items()) {
         v->setParentItem(nullptr);
         v->deleteLater();
     }
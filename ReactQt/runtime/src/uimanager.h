@@ -16,15 +16,20 @@
 
 #include <QLoggingCategory>
 #include <QObject>
+#include <QSet>
 #include <QString>
 #include <QVariant>
 
+#include <functional>
+
 #include "moduleinterface.h"
+#include "viewregistry.h"
 
 Q_DECLARE_LOGGING_CATEGORY(UIMANAGER)
 
 class Bridge;
 class ComponentData;
+class IncubationController;
 class QQuickItem;
 
 class UIManager : public QObject, public ModuleInterface {
@@ -90,17 +95,34 @@ public:
     QQuickItem* viewForTag(int reactTag);
     void stopTrackingTagsForHierarchy(QQuickItem* topItem);
 
+    // Per frame time budget for incubating QML views, 0 means views are created synchronously
+    int incubationBudget() const;
+    void setIncubationBudget(int msecs);
+
 private:
-    QList<QQuickItem*> removeChildrenFromVisualParent(QQuickItem* parent, const QList<int>& removeAtIndices);
+    QList<QQuickItem*> removeChildrenFromVisualParent(QQuickItem* parent,
+                                                      const QList<int>& removeAtIndices,
+                                                      bool removeFlexboxChilds = true);
     void destroyComponents(const QList<QQuickItem*> items);
+    void recycleOrDestroy(QQuickItem* item);
+    void registerView(int reactTag, QQuickItem* item, const QVariantMap& props);
+    bool incubationAvailable();
+    bool deferWhileIncubating(const std::function<void()>& operation);
+    void flushDeferredOperations();
 
 private:
     static int m_nextRootTag;
 
     Bridge* m_bridge;
     QMap<QString, ComponentData*> m_componentData;
-    QMap<int, QQuickItem*> m_views;
+    ViewRegistry m_views;
     int m_rootTag = -1;
+
+    int m_incubationBudget = 0;
+    int m_incubationGeneration = 0;
+    IncubationController* m_incubationController = nullptr;
+    QSet<int> m_incubatingTags;
+    QList<std::function<void()>> m_deferredOperations;
 };
 
 #endif // UIMANAGER_H
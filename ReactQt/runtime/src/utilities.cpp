@@ -20,6 +20,7 @@
 #include "layout/flexbox.h"
 #include "mouseeventsinterceptor.h"
 #include "reactitem.h"
+#include "reactview.h"
 #include "rootview.h"
 #include "utilities.h"
 
@@ -33,6 +34,11 @@ MatrixTransform::MatrixTransform(const QVector<float>& transformMatrix, QQuickIt
     memcpy(m_transformMatrix.data(), transformMatrix.constData(), 16 * sizeof(float));
     m_transformMatrix.optimize();
 }
+void MatrixTransform::setTransformMatrix(const QVector<float>& transformMatrix) {
+    memcpy(m_transformMatrix.data(), transformMatrix.constData(), 16 * sizeof(float));
+    m_transformMatrix.optimize();
+    update();
+}
 void MatrixTransform::applyTo(QMatrix4x4* matrix) const {
     if (m_transformMatrix.isIdentity())
         return;
@@ -45,6 +51,7 @@ void registerReactTypes() {
     qmlRegisterUncreatableType<AttachedProperties>(
         "React", MAJOR_VERSION, MINOR_VERSION, "React", "React is not meant to be created directly");
     qmlRegisterType<ReactItem>("React", MAJOR_VERSION, MINOR_VERSION, "Item");
+    qmlRegisterType<ReactView>("React", MAJOR_VERSION, MINOR_VERSION, "View");
     qmlRegisterType<RootView>("React", MAJOR_VERSION, MINOR_VERSION, "RootView");
     qmlRegisterType<MouseEventsInterceptor>("React", MAJOR_VERSION, MINOR_VERSION, "MouseEventsInterceptor");
 
@@ -111,20 +118,80 @@ QObject* createQObjectInstance(const QString& typeName) {
     return mObj->newInstance();
 }
 
+void setItemTransform(QQuickItem* item, const QVector<float>& transformMatrix) {
+    QQmlListReference r(item, "transform");
+
+    // Animated transforms are set every frame, so the one already attached is updated in place.
+    // Other transforms in the list, like the translation of scroll bindings, are left alone.
+    for (int i = 0; i < r.count(); ++i) {
+        MatrixTransform* transform = dynamic_cast<MatrixTransform*>(r.at(i));
+        if (transform) {
+            transform->setTransformMatrix(transformMatrix);
+            return;
+        }
+    }
+    if (r.canAppend()) {
+        r.append(new MatrixTransform(transformMatrix, item));
+    }
+}
+
 void insertChildItemAt(QQuickItem* item, int position, QQuickItem* parent) {
-    if (!item || !parent)
+    insertChildItemsAt(QList<QQuickItem*>{item}, QList<int>{position}, parent);
+}
+
+void insertChildItemsAt(const QList<QQuickItem*>& items, const QList<int>& positions, QQuickItem* parent) {
+    Q_ASSERT(items.size() == positions.size());
+    if (!parent)
         return;
 
-    QList<QQuickItem*> childItems = parent->childItems();
-    if (childItems.size() && childItems.size() > position) {
-        QQuickItem* nextItem = childItems.at(position);
-        item->setParentItem(parent);
-        item->setParent(parent);
-        item->stackBefore(nextItem);
-    } else {
+    // Siblings are looked up in the list taken before any insertion. The copy is released before
+    // reparenting, otherwise every setParentItem() would detach and copy the parent's child list.
+    QList<QQuickItem*> nextItems;
+    {
+        const QList<QQuickItem*> childItems = parent->childItems();
+        int inserted = 0;
+        for (int i = 0; i < items.size(); ++i) {
+            int siblingIndex = positions.at(i) - inserted;
+            nextItems.push_back(siblingIndex >= 0 && siblingIndex < childItems.size() ? childItems.at(siblingIndex)
+                                                                                     : nullptr);
+            if (items.at(i)) {
+                ++inserted;
+            }
+        }
+    }
+
+    for (int i = 0; i < items.size(); ++i) {
+        QQuickItem* item = items.at(i);
+        if (!item)
+            continue;
+
         item->setParentItem(parent);
-        item->setParent(parent);
+        if (item->parent() != parent) {
+            item->setParent(parent);
+        }
+        // Appended items are already in place
+        if (nextItems.at(i)) {
+            item->stackBefore(nextItems.at(i));
+        }
+    }
+}
+
+QList<QQuickItem*> takeChildItemsAt(QQuickItem* parent, const QList<int>& indices) {
+    QList<QQuickItem*> takenItems;
+    if (!parent || indices.isEmpty())
+        return takenItems;
+
+    {
+        const QList<QQuickItem*> childItems = parent->childItems();
+        for (int index : indices) {
+            takenItems.push_back(childItems.at(index));
+        }
+    }
+
+    for (QQuickItem* child : takenItems) {
+        child->setParentItem(nullptr);
     }
+    return takenItems;
 }
 
 void removeFlexboxChilds(QQuickItem* item, const QList<int>& removeAtIndices) {
@@ -30,6 +30,7 @@ class MatrixTransform : public QQuickTransform {
 public:
     MatrixTransform(const QVector<float>& transformMatrix, QQuickItem* parent);
     void applyTo(QMatrix4x4* matrix) const override;
+    void setTransformMatrix(const QVector<float>& transformMatrix);
     QMatrix4x4 m_transformMatrix;
     QQuickItem* m_item;
 };
@@ -43,6 +44,12 @@ QmlComponentPtr createComponentFromSourceFile(QQmlEngine* qmlEngine, const QUrl&
 QQuickItem* createQMLItemFromComponent(QmlComponentPtr component);
 QObject* createQObjectInstance(const QString& typeName);
 void insertChildItemAt(QQuickItem* item, int position, QQuickItem* parent);
+// Sets the matrix of the item's MatrixTransform, which is created if the item has none
+void setItemTransform(QQuickItem* item, const QVector<float>& transformMatrix);
+// Inserts items at ascending positions of the resulting child list, reading parent's children only once
+void insertChildItemsAt(const QList<QQuickItem*>& items, const QList<int>& positions, QQuickItem* parent);
+// Unparents the children at indices of the current child list and returns them in the order of indices
+QList<QQuickItem*> takeChildItemsAt(QQuickItem* parent, const QList<int>& indices);
 void removeFlexboxChilds(QQuickItem* item, const QList<int>& removeAtIndices);
 QVariantMap createTouchArgs(int tag, const QPointF& lp, const QPointF& local, const QString& button, ulong timestamp);
 QQuickItem* getChildFromScrollView(QQuickItem* scrollView, const QPointF& scrollViewPos);
@@ -113,7 +113,8 @@ QVariant reactCoerceValue(const QVariant& data, int parameterType, const coerce_
         return QVariant(parameterType, QMetaType::create(parameterType));
     }
 
-    if (data.type() == parameterType || parameterType == QMetaType::QVariant) {
+    // userType(), as type() is UserType for all custom types, e.g. callback blocks built by host objects
+    if (data.userType() == parameterType || parameterType == QMetaType::QVariant) {
         return data;
     }
 
@@ -0,0 +1,130 @@
+
+/**
+ * Copyright (c) 2017-present, Status Research and Development GmbH.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "viewregistry.h"
+
+namespace {
+const int INITIAL_CAPACITY = 256;
+} // namespace
+
+ViewRegistry::ViewRegistry() {
+    m_slots.resize(INITIAL_CAPACITY);
+}
+
+void ViewRegistry::insert(int tag, QQuickItem* item) {
+    Q_ASSERT(item != nullptr);
+
+    // Keep load factor under 3/4 so probe sequences stay short
+    if ((m_size + 1) * 4 > m_slots.size() * 3) {
+        rehash(m_slots.size() * 2);
+    }
+
+    const int mask = m_slots.size() - 1;
+    int i = homeIndex(tag);
+    while (m_slots[i].item && m_slots[i].tag != tag) {
+        i = (i + 1) & mask;
+    }
+
+    Slot& slot = m_slots[i];
+    if (slot.item) {
+        m_tags.remove(slot.item);
+    } else {
+        ++m_size;
+    }
+    slot.tag = tag;
+    slot.item = item;
+    m_tags.insert(item, tag);
+}
+
+void ViewRegistry::remove(int tag) {
+    int hole = indexOf(tag);
+    if (hole == -1)
+        return;
+
+    m_tags.remove(m_slots[hole].item);
+    --m_size;
+
+    // Backward shift deletion: pull following entries of the probe sequence
+    // into the hole, so lookups never need tombstones
+    const int mask = m_slots.size() - 1;
+    int next = hole;
+    forever {
+        next = (next + 1) & mask;
+        const Slot& candidate = m_slots[next];
+        if (!candidate.item)
+            break;
+        const int home = homeIndex(candidate.tag);
+        const bool homeInRange = hole <= next ? (hole < home && home <= next) : (hole < home || home <= next);
+        if (!homeInRange) {
+            m_slots[hole] = candidate;
+            hole = next;
+        }
+    }
+    m_slots[hole] = Slot();
+}
+
+void ViewRegistry::clear() {
+    m_slots.fill(Slot());
+    m_tags.clear();
+    m_size = 0;
+}
+
+QQuickItem* ViewRegistry::value(int tag) const {
+    int i = indexOf(tag);
+    return i == -1 ? nullptr : m_slots[i].item;
+}
+
+int ViewRegistry::tag(QQuickItem* item) const {
+    return m_tags.value(item, -1);
+}
+
+bool ViewRegistry::contains(int tag) const {
+    return indexOf(tag) != -1;
+}
+
+int ViewRegistry::size() const {
+    return m_size;
+}
+
+QList<QQuickItem*> ViewRegistry::items() const {
+    return m_tags.keys();
+}
+
+int ViewRegistry::indexOf(int tag) const {
+    const int mask = m_slots.size() - 1;
+    int i = homeIndex(tag);
+    while (m_slots[i].item) {
+        if (m_slots[i].tag == tag)
+            return i;
+        i = (i + 1) & mask;
+    }
+    return -1;
+}
+
+int ViewRegistry::homeIndex(int tag) const {
+    return static_cast<int>(static_cast<uint>(tag) & static_cast<uint>(m_slots.size() - 1));
+}
+
+void ViewRegistry::rehash(int capacity) {
+    QVector<Slot> oldSlots(capacity);
+    oldSlots.swap(m_slots);
+
+    const int mask = capacity - 1;
+    for (const Slot& slot : oldSlots) {
+        if (!slot.item)
+            continue;
+        int i = homeIndex(slot.tag);
+        while (m_slots[i].item) {
+            i = (i + 1) & mask;
+        }
+        m_slots[i] = slot;
+    }
+}
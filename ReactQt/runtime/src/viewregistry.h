@@ -0,0 +1,56 @@
+
+/**
+ * Copyright (c) 2017-present, Status Research and Development GmbH.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#ifndef VIEWREGISTRY_H
+#define VIEWREGISTRY_H
+
+#include <QHash>
+#include <QList>
+#include <QVector>
+
+class QQuickItem;
+
+// Tag -> item map for views managed by UIManager.
+// React tags are small, mostly consecutive integers, so they are stored in an
+// open addressing table indexed by the low bits of the tag, which keeps the
+// common case collision free. Reverse lookups go through a separate item -> tag
+// index instead of scanning the table.
+class ViewRegistry {
+public:
+    ViewRegistry();
+
+    void insert(int tag, QQuickItem* item);
+    void remove(int tag);
+    void clear();
+
+    QQuickItem* value(int tag) const;
+    int tag(QQuickItem* item) const;
+    bool contains(int tag) const;
+    int size() const;
+
+    QList<QQuickItem*> items() const;
+
+private:
+    struct Slot {
+        int tag = 0;
+        QQuickItem* item = nullptr;
+    };
+
+    int indexOf(int tag) const;
+    int homeIndex(int tag) const;
+    void rehash(int capacity);
+
+    QVector<Slot> m_slots;
+    QHash<QQuickItem*, int> m_tags;
+    int m_size = 0;
+};
+
+#endif // VIEWREGISTRY_H
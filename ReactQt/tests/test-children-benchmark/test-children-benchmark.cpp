@@ -0,0 +1,194 @@
+/**
+ * Copyright (c) 2017-present, Status Research and Development GmbH.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include <QElapsedTimer>
+#include <QScopedPointer>
+#include <QTest>
+#include <QtQuick/QQuickItem>
+
+#include "utilities.h"
+
+const int CHILDREN_COUNT = 10000;
+const int ITERATIONS_COUNT = 5;
+
+class TestChildrenBenchmark : public QObject {
+    Q_OBJECT
+
+private slots:
+    void init();
+    void cleanup();
+
+    void testChildrenOrder();
+    void benchmarkAppendChildren();
+    void benchmarkAppendChildrenBatch();
+    void benchmarkInsertFirstChild();
+    void benchmarkDeleteLastChild();
+    void benchmarkItemMove();
+
+private:
+    QList<QQuickItem*> createItems(int count);
+    QList<int> positions(int from, int count);
+    void fillParent();
+    void reportResult(qint64 elapsed);
+
+    QScopedPointer<QQuickItem> m_parentItem;
+};
+
+void TestChildrenBenchmark::init() {
+    m_parentItem.reset(new QQuickItem());
+}
+
+void TestChildrenBenchmark::cleanup() {
+    m_parentItem.reset();
+}
+
+QList<QQuickItem*> TestChildrenBenchmark::createItems(int count) {
+    QList<QQuickItem*> items;
+    for (int i = 0; i < count; ++i) {
+        QQuickItem* item = new QQuickItem();
+        item->setObjectName(QString::number(i));
+        items.push_back(item);
+    }
+    return items;
+}
+
+QList<int> TestChildrenBenchmark::positions(int from, int count) {
+    QList<int> result;
+    for (int i = 0; i < count; ++i) {
+        result.push_back(from + i);
+    }
+    return result;
+}
+
+void TestChildrenBenchmark::fillParent() {
+    utilities::insertChildItemsAt(createItems(CHILDREN_COUNT), positions(0, CHILDREN_COUNT), m_parentItem.data());
+}
+
+void TestChildrenBenchmark::reportResult(qint64 elapsed) {
+    QTest::setBenchmarkResult(qreal(elapsed) / ITERATIONS_COUNT / 1000000, QTest::WalltimeMilliseconds);
+}
+
+void TestChildrenBenchmark::testChildrenOrder() {
+    QList<QQuickItem*> items = createItems(4);
+    utilities::insertChildItemsAt(QList<QQuickItem*>{items[1], items[3]}, QList<int>{0, 1}, m_parentItem.data());
+    // Positions are in the resulting list, so 0 and 2 end up in front of 1 and 3
+    utilities::insertChildItemsAt(QList<QQuickItem*>{items[0], items[2]}, QList<int>{0, 2}, m_parentItem.data());
+    QCOMPARE(m_parentItem->childItems(), items);
+    for (QQuickItem* item : items) {
+        QCOMPARE(item->parent(), m_parentItem.data());
+    }
+
+    QList<QQuickItem*> taken = utilities::takeChildItemsAt(m_parentItem.data(), QList<int>{3, 0});
+    QCOMPARE(taken, (QList<QQuickItem*>{items[3], items[0]}));
+    QCOMPARE(m_parentItem->childItems(), (QList<QQuickItem*>{items[1], items[2]}));
+
+    utilities::insertChildItemAt(items[3], 0, m_parentItem.data());
+    utilities::insertChildItemAt(items[0], 3, m_parentItem.data());
+    QCOMPARE(m_parentItem->childItems(), (QList<QQuickItem*>{items[3], items[1], items[2], items[0]}));
+}
+
+void TestChildrenBenchmark::benchmarkAppendChildren() {
+    qint64 elapsed = 0;
+    QElapsedTimer timer;
+
+    for (int i = 0; i < ITERATIONS_COUNT; ++i) {
+        init();
+        QList<QQuickItem*> items = createItems(CHILDREN_COUNT);
+
+        timer.start();
+        for (int position = 0; position < items.size(); ++position) {
+            utilities::insertChildItemAt(items[position], position, m_parentItem.data());
+        }
+        elapsed += timer.nsecsElapsed();
+    }
+
+    QCOMPARE(m_parentItem->childItems().size(), CHILDREN_COUNT);
+    reportResult(elapsed);
+}
+
+void TestChildrenBenchmark::benchmarkAppendChildrenBatch() {
+    qint64 elapsed = 0;
+    QElapsedTimer timer;
+
+    for (int i = 0; i < ITERATIONS_COUNT; ++i) {
+        init();
+        QList<QQuickItem*> items = createItems(CHILDREN_COUNT);
+        QList<int> itemPositions = positions(0, CHILDREN_COUNT);
+
+        timer.start();
+        utilities::insertChildItemsAt(items, itemPositions, m_parentItem.data());
+        elapsed += timer.nsecsElapsed();
+    }
+
+    QCOMPARE(m_parentItem->childItems().size(), CHILDREN_COUNT);
+    reportResult(elapsed);
+}
+
+void TestChildrenBenchmark::benchmarkInsertFirstChild() {
+    fillParent();
+
+    qint64 elapsed = 0;
+    QElapsedTimer timer;
+
+    for (int i = 0; i < ITERATIONS_COUNT; ++i) {
+        QQuickItem* item = new QQuickItem();
+
+        timer.start();
+        utilities::insertChildItemAt(item, 0, m_parentItem.data());
+        elapsed += timer.nsecsElapsed();
+
+        QCOMPARE(m_parentItem->childItems().first(), item);
+    }
+
+    reportResult(elapsed);
+}
+
+void TestChildrenBenchmark::benchmarkDeleteLastChild() {
+    fillParent();
+
+    qint64 elapsed = 0;
+    QElapsedTimer timer;
+
+    for (int i = 0; i < ITERATIONS_COUNT; ++i) {
+        const int lastIndex = m_parentItem->childItems().size() - 1;
+
+        timer.start();
+        QList<QQuickItem*> taken = utilities::takeChildItemsAt(m_parentItem.data(), QList<int>{lastIndex});
+        elapsed += timer.nsecsElapsed();
+
+        QCOMPARE(m_parentItem->childItems().size(), lastIndex);
+        qDeleteAll(taken);
+    }
+
+    reportResult(elapsed);
+}
+
+void TestChildrenBenchmark::benchmarkItemMove() {
+    fillParent();
+
+    qint64 elapsed = 0;
+    QElapsedTimer timer;
+
+    for (int i = 0; i < ITERATIONS_COUNT; ++i) {
+        // Moves the first child to the end, the way manageChildren does it
+        timer.start();
+        QList<QQuickItem*> moved = utilities::takeChildItemsAt(m_parentItem.data(), QList<int>{0});
+        utilities::insertChildItemsAt(moved, QList<int>{CHILDREN_COUNT - 1}, m_parentItem.data());
+        elapsed += timer.nsecsElapsed();
+
+        QCOMPARE(m_parentItem->childItems().last(), moved.first());
+    }
+
+    QCOMPARE(m_parentItem->childItems().first()->objectName(), QString::number(ITERATIONS_COUNT));
+    reportResult(elapsed);
+}
+
+QTEST_MAIN(TestChildrenBenchmark)
+#include "test-children-benchmark.moc"
@@ -0,0 +1,109 @@
+/**
+ * Copyright (c) 2017-present, Status Research and Development GmbH.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include <QTest>
+
+#include "interpolation.h"
+
+class TestInterpolation : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testSingleSegment();
+    void testMultipleSegments();
+    void testExtend();
+    void testClamp();
+    void testIdentity();
+    void testExtrapolateFromConfig();
+    void testEqualInputPoints();
+    void testInvalidRanges();
+};
+
+void TestInterpolation::testSingleSegment() {
+    Interpolation interpolation({0, 1}, {0, 10});
+    QVERIFY(interpolation.isValid());
+    QCOMPARE(interpolation.evaluate(0), 0.0);
+    QCOMPARE(interpolation.evaluate(0.25), 2.5);
+    QCOMPARE(interpolation.evaluate(1), 10.0);
+}
+
+void TestInterpolation::testMultipleSegments() {
+    Interpolation interpolation({0, 1, 3}, {0, 10, 0});
+    QCOMPARE(interpolation.evaluate(0.5), 5.0);
+    QCOMPARE(interpolation.evaluate(1), 10.0);
+    QCOMPARE(interpolation.evaluate(2), 5.0);
+    QCOMPARE(interpolation.evaluate(3), 0.0);
+}
+
+void TestInterpolation::testExtend() {
+    // Past the ends the first and the last segments go on
+    Interpolation interpolation({0, 1, 3}, {0, 10, 0});
+    QCOMPARE(interpolation.evaluate(-1), -10.0);
+    QCOMPARE(interpolation.evaluate(5), -10.0);
+}
+
+void TestInterpolation::testClamp() {
+    Interpolation interpolation({0, 1, 3}, {0, 10, 0}, Interpolation::Clamp, Interpolation::Clamp);
+    QCOMPARE(interpolation.evaluate(-1), 0.0);
+    QCOMPARE(interpolation.evaluate(5), 0.0);
+
+    Interpolation ascending({0, 1}, {0, 10}, Interpolation::Clamp, Interpolation::Clamp);
+    QCOMPARE(ascending.evaluate(2), 10.0);
+    QCOMPARE(ascending.evaluate(0.5), 5.0);
+}
+
+void TestInterpolation::testIdentity() {
+    Interpolation interpolation({0, 1}, {100, 200}, Interpolation::Identity, Interpolation::Identity);
+    QCOMPARE(interpolation.evaluate(-3), -3.0);
+    QCOMPARE(interpolation.evaluate(5), 5.0);
+    QCOMPARE(interpolation.evaluate(0.5), 150.0);
+}
+
+void TestInterpolation::testExtrapolateFromConfig() {
+    Interpolation both = Interpolation::fromConfig(QVariantMap{{"inputRange", QVariantList{0, 1}},
+                                                               {"outputRange", QVariantList{0, 10}},
+                                                               {"extrapolate", "clamp"}});
+    QCOMPARE(both.evaluate(-1), 0.0);
+    QCOMPARE(both.evaluate(2), 10.0);
+
+    // Side specific modes override extrapolate
+    Interpolation sides = Interpolation::fromConfig(QVariantMap{{"inputRange", QVariantList{0, 1}},
+                                                                {"outputRange", QVariantList{0, 10}},
+                                                                {"extrapolate", "clamp"},
+                                                                {"extrapolateRight", "identity"}});
+    QCOMPARE(sides.evaluate(-1), 0.0);
+    QCOMPARE(sides.evaluate(2), 2.0);
+
+    Interpolation defaults = Interpolation::fromConfig(
+        QVariantMap{{"inputRange", QVariantList{0, 1}}, {"outputRange", QVariantList{0, 10}}});
+    QCOMPARE(defaults.evaluate(2), 20.0);
+}
+
+void TestInterpolation::testEqualInputPoints() {
+    Interpolation interpolation({0, 0}, {1, 2});
+    QCOMPARE(interpolation.evaluate(-1), 1.0);
+    QCOMPARE(interpolation.evaluate(0), 1.0);
+    QCOMPARE(interpolation.evaluate(1), 2.0);
+}
+
+void TestInterpolation::testInvalidRanges() {
+    // Invalid interpolations pass the input through
+    Interpolation descending({1, 0}, {0, 10});
+    QVERIFY(!descending.isValid());
+    QCOMPARE(descending.evaluate(0.5), 0.5);
+
+    Interpolation mismatched({0, 1, 2}, {0, 10});
+    QVERIFY(!mismatched.isValid());
+
+    QVERIFY(!Interpolation().isValid());
+}
+
+QTEST_MAIN(TestInterpolation)
+#include "test-interpolation.moc"
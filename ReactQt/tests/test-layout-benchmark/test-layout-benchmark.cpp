@@ -0,0 +1,160 @@
+/**
+ * Copyright (c) 2017-present, Status Research and Development GmbH.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include <QElapsedTimer>
+#include <QLoggingCategory>
+#include <QScopedPointer>
+#include <QTest>
+#include <QtQuick/QQuickItem>
+
+#include "layout/flexbox.h"
+
+// 1 root + 100 rows + 100 * 99 cells
+const int ROWS_COUNT = 100;
+const int CELLS_PER_ROW = 99;
+const int ROW_HEIGHT = 10;
+const int ITERATIONS_COUNT = 20;
+
+class TestLayoutBenchmark : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void init();
+    void cleanup();
+
+    void testLayoutApplied();
+    void testNodesRecycled();
+    void benchmarkCalculateLayout();
+    void benchmarkApplyLayout();
+    void benchmarkApplyUnchangedLayout();
+
+private:
+    Flexbox* createFlexbox(QQuickItem* parentItem, Flexbox* parentFlexbox, int index);
+    QQuickItem* cell(int row, int column) const;
+
+    QScopedPointer<QQuickItem> m_rootItem;
+    Flexbox* m_rootFlexbox = nullptr;
+};
+
+void TestLayoutBenchmark::initTestCase() {
+    // Items have no view manager to send onLayout events with
+    QLoggingCategory::setFilterRules("Flexbox.warning=false");
+}
+
+void TestLayoutBenchmark::init() {
+    m_rootItem.reset(new QQuickItem());
+    m_rootFlexbox = new Flexbox(m_rootItem.data());
+    m_rootFlexbox->setControl(m_rootItem.data());
+
+    for (int row = 0; row < ROWS_COUNT; ++row) {
+        Flexbox* rowFlexbox = createFlexbox(m_rootItem.data(), m_rootFlexbox, row);
+        rowFlexbox->setFlexDirection("row");
+        rowFlexbox->setHeight(ROW_HEIGHT);
+
+        for (int column = 0; column < CELLS_PER_ROW; ++column) {
+            Flexbox* cellFlexbox = createFlexbox(rowFlexbox->control(), rowFlexbox, column);
+            cellFlexbox->setFlexGrow(1);
+        }
+    }
+}
+
+void TestLayoutBenchmark::cleanup() {
+    m_rootFlexbox = nullptr;
+    m_rootItem.reset();
+}
+
+Flexbox* TestLayoutBenchmark::createFlexbox(QQuickItem* parentItem, Flexbox* parentFlexbox, int index) {
+    QQuickItem* item = new QQuickItem(parentItem);
+    Flexbox* flexbox = new Flexbox(item);
+    flexbox->setControl(item);
+    parentFlexbox->addChild(index, flexbox);
+    return flexbox;
+}
+
+QQuickItem* TestLayoutBenchmark::cell(int row, int column) const {
+    return m_rootItem->childItems().at(row)->childItems().at(column);
+}
+
+void TestLayoutBenchmark::testLayoutApplied() {
+    m_rootFlexbox->recalculateLayout(CELLS_PER_ROW * 10, ROWS_COUNT * ROW_HEIGHT);
+
+    QQuickItem* lastCell = cell(ROWS_COUNT - 1, CELLS_PER_ROW - 1);
+    QCOMPARE(lastCell->x(), qreal((CELLS_PER_ROW - 1) * 10));
+    QCOMPARE(lastCell->width(), qreal(10));
+    QCOMPARE(lastCell->height(), qreal(ROW_HEIGHT));
+    QCOMPARE(lastCell->parentItem()->y(), qreal((ROWS_COUNT - 1) * ROW_HEIGHT));
+
+    // Pruned walk must still pick up the new frames after a resize
+    m_rootFlexbox->recalculateLayout(CELLS_PER_ROW * 20, ROWS_COUNT * ROW_HEIGHT);
+    QCOMPARE(lastCell->x(), qreal((CELLS_PER_ROW - 1) * 20));
+    QCOMPARE(lastCell->width(), qreal(20));
+}
+
+void TestLayoutBenchmark::testNodesRecycled() {
+    const int nodesCount = 1 + ROWS_COUNT * (1 + CELLS_PER_ROW);
+    QCOMPARE(Flexbox::liveNodeCount(), nodesCount);
+    QVERIFY(Flexbox::peakNodeCount() >= nodesCount);
+
+    Flexbox::setNodePoolCapacity(nodesCount);
+    m_rootItem.reset();
+    m_rootFlexbox = nullptr;
+    QCOMPARE(Flexbox::liveNodeCount(), 0);
+    QCOMPARE(Flexbox::pooledNodeCount(), nodesCount);
+
+    // Tree built from recycled nodes lays out like a fresh one
+    init();
+    QCOMPARE(Flexbox::pooledNodeCount(), 0);
+    testLayoutApplied();
+}
+
+void TestLayoutBenchmark::benchmarkCalculateLayout() {
+    int iteration = 0;
+    QBENCHMARK {
+        // Alternating width invalidates the layout of every node
+        m_rootFlexbox->calculateLayout(CELLS_PER_ROW * (10 + iteration++ % 2), ROWS_COUNT * ROW_HEIGHT);
+    }
+}
+
+void TestLayoutBenchmark::benchmarkApplyLayout() {
+    qint64 elapsed = 0;
+    QElapsedTimer timer;
+
+    for (int i = 0; i < ITERATIONS_COUNT; ++i) {
+        m_rootFlexbox->calculateLayout(CELLS_PER_ROW * (10 + i % 2), ROWS_COUNT * ROW_HEIGHT);
+
+        timer.start();
+        m_rootFlexbox->applyLayout();
+        elapsed += timer.nsecsElapsed();
+    }
+
+    QTest::setBenchmarkResult(qreal(elapsed) / ITERATIONS_COUNT / 1000000, QTest::WalltimeMilliseconds);
+}
+
+void TestLayoutBenchmark::benchmarkApplyUnchangedLayout() {
+    m_rootFlexbox->recalculateLayout(CELLS_PER_ROW * 10, ROWS_COUNT * ROW_HEIGHT);
+
+    qint64 elapsed = 0;
+    QElapsedTimer timer;
+
+    for (int i = 0; i < ITERATIONS_COUNT; ++i) {
+        // Same size, so Yoga reuses the cached layout of the whole tree
+        m_rootFlexbox->calculateLayout(CELLS_PER_ROW * 10, ROWS_COUNT * ROW_HEIGHT);
+
+        timer.start();
+        m_rootFlexbox->applyLayout();
+        elapsed += timer.nsecsElapsed();
+    }
+
+    QTest::setBenchmarkResult(qreal(elapsed) / ITERATIONS_COUNT / 1000000, QTest::WalltimeMilliseconds);
+}
+
+QTEST_MAIN(TestLayoutBenchmark)
+#include "test-layout-benchmark.moc"
@@ -0,0 +1,149 @@
+/**
+ * Copyright (c) 2017-present, Status Research and Development GmbH.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include <QScopedPointer>
+#include <QTest>
+#include <QtQuick/QQuickItem>
+
+#include "layout/flexbox.h"
+
+const int CHILDREN_COUNT = 3;
+const int ROOT_WIDTH = 100;
+const int ROOT_HEIGHT = 100;
+const int CHILD_HEIGHT = 10;
+const int RESIZED_CHILD_HEIGHT = 30;
+const int COMMIT_TIMEOUT = 1000;
+
+// Passes of recalculateLayoutAsync() lay out a copy of the tree, which the GUI thread keeps changing meanwhile
+class TestLayoutThread : public QObject {
+    Q_OBJECT
+
+private slots:
+    void init();
+    void cleanup();
+
+    void testLayoutCommitted();
+    void testChangedDuringPass();
+    void testDestroyedDuringPass();
+    void testRootsLayOutIndependently();
+
+private:
+    Flexbox* attachFlexbox(QQuickItem* item);
+    void layout(Flexbox* root);
+    QQuickItem* child(int position) const;
+
+    QScopedPointer<QQuickItem> m_rootItem;
+    Flexbox* m_rootFlexbox = nullptr;
+    QList<Flexbox*> m_children;
+};
+
+void TestLayoutThread::init() {
+    m_rootItem.reset(new QQuickItem());
+    m_rootFlexbox = attachFlexbox(m_rootItem.data());
+
+    QList<int> addAtIndices;
+    for (int i = 0; i < CHILDREN_COUNT; ++i) {
+        Flexbox* flexbox = attachFlexbox(new QQuickItem(m_rootItem.data()));
+        flexbox->setHeight(CHILD_HEIGHT);
+        m_children.push_back(flexbox);
+        addAtIndices.push_back(i);
+    }
+    m_rootFlexbox->updateChildren(QList<int>(), addAtIndices, m_children);
+}
+
+void TestLayoutThread::cleanup() {
+    m_children.clear();
+    m_rootFlexbox = nullptr;
+    m_rootItem.reset();
+}
+
+Flexbox* TestLayoutThread::attachFlexbox(QQuickItem* item) {
+    Flexbox* flexbox = new Flexbox(item);
+    flexbox->setControl(item);
+    item->setProperty("flexbox", QVariant::fromValue(flexbox));
+    return flexbox;
+}
+
+void TestLayoutThread::layout(Flexbox* root) {
+    bool committed = false;
+    root->recalculateLayoutAsync(ROOT_WIDTH, ROOT_HEIGHT, [&committed]() { committed = true; });
+    QVERIFY(root->isLayoutInFlight());
+    QTRY_VERIFY_WITH_TIMEOUT(committed, COMMIT_TIMEOUT);
+    QVERIFY(!root->isLayoutInFlight());
+}
+
+QQuickItem* TestLayoutThread::child(int position) const {
+    return m_children.at(position)->control();
+}
+
+void TestLayoutThread::testLayoutCommitted() {
+    layout(m_rootFlexbox);
+
+    QCOMPARE(m_rootItem->width(), qreal(ROOT_WIDTH));
+    QCOMPARE(child(2)->y(), qreal(2 * CHILD_HEIGHT));
+    QCOMPARE(child(2)->width(), qreal(ROOT_WIDTH));
+    QVERIFY(!m_rootFlexbox->isDirty());
+}
+
+void TestLayoutThread::testChangedDuringPass() {
+    bool committed = false;
+    m_rootFlexbox->recalculateLayoutAsync(ROOT_WIDTH, ROOT_HEIGHT, [&committed]() { committed = true; });
+    m_children.at(0)->setHeight(RESIZED_CHILD_HEIGHT);
+    QTRY_VERIFY_WITH_TIMEOUT(committed, COMMIT_TIMEOUT);
+
+    // The pass laid out the tree as it was when it started, and the change waits for the next one
+    QCOMPARE(child(0)->height(), qreal(CHILD_HEIGHT));
+    QCOMPARE(child(1)->y(), qreal(CHILD_HEIGHT));
+    QVERIFY(m_rootFlexbox->isDirty());
+
+    layout(m_rootFlexbox);
+    QCOMPARE(child(0)->height(), qreal(RESIZED_CHILD_HEIGHT));
+    QCOMPARE(child(1)->y(), qreal(RESIZED_CHILD_HEIGHT));
+    QVERIFY(!m_rootFlexbox->isDirty());
+}
+
+void TestLayoutThread::testDestroyedDuringPass() {
+    const int liveNodeCount = Flexbox::liveNodeCount();
+
+    bool committed = false;
+    m_rootFlexbox->recalculateLayoutAsync(ROOT_WIDTH, ROOT_HEIGHT, [&committed]() { committed = true; });
+    delete m_children.takeAt(1)->control();
+
+    // The shadow tree still refers to the node, it is released with the commit
+    QCOMPARE(Flexbox::liveNodeCount(), liveNodeCount);
+    QTRY_VERIFY_WITH_TIMEOUT(committed, COMMIT_TIMEOUT);
+    QCOMPARE(Flexbox::liveNodeCount(), liveNodeCount - 1);
+    QVERIFY(m_rootFlexbox->isDirty());
+
+    layout(m_rootFlexbox);
+    QCOMPARE(child(1)->y(), qreal(CHILD_HEIGHT));
+}
+
+void TestLayoutThread::testRootsLayOutIndependently() {
+    QScopedPointer<QQuickItem> otherRootItem(new QQuickItem());
+    Flexbox* otherRoot = attachFlexbox(otherRootItem.data());
+
+    bool committed = false;
+    m_rootFlexbox->recalculateLayoutAsync(ROOT_WIDTH, ROOT_HEIGHT, [&committed]() { committed = true; });
+
+    // A pass in flight neither holds back passes of other roots nor changes of their trees
+    QVERIFY(!otherRoot->isLayoutInFlight());
+    Flexbox* otherChild = attachFlexbox(new QQuickItem(otherRootItem.data()));
+    otherChild->setHeight(CHILD_HEIGHT);
+    otherRoot->updateChildren(QList<int>(), QList<int>{0}, QList<Flexbox*>{otherChild});
+    layout(otherRoot);
+    QCOMPARE(otherChild->control()->height(), qreal(CHILD_HEIGHT));
+
+    QTRY_VERIFY_WITH_TIMEOUT(committed, COMMIT_TIMEOUT);
+    QCOMPARE(child(2)->y(), qreal(2 * CHILD_HEIGHT));
+}
+
+QTEST_MAIN(TestLayoutThread)
+#include "test-layout-thread.moc"
@@ -0,0 +1,158 @@
+/**
+ * Copyright (c) 2017-present, Status Research and Development GmbH.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include <QLoggingCategory>
+#include <QScopedPointer>
+#include <QTest>
+#include <QtQuick/QQuickItem>
+
+#include "componentmanagers/scrollviewmodel.h"
+#include "layout/flexbox.h"
+
+const int ROWS_COUNT = 10;
+const int ROW_WIDTH = 100;
+const int ROW_HEIGHT = 10;
+const int RESIZED_ROW_HEIGHT = 40;
+
+// Rows of a windowed list, diffed the way UIManager::manageChildren() applies them to a scroll view
+class TestScrollViewWindow : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void init();
+    void cleanup();
+
+    void testFrozenRowsKeepLayout();
+    void testInsertedRowFrozen();
+    void testMovedRowFrozen();
+
+private:
+    Flexbox* createRow();
+    void insertRow(Flexbox* row, int position);
+    void moveRow(int from, int to);
+    void layout();
+    QQuickItem* row(int position) const;
+
+    QScopedPointer<QQuickItem> m_rootItem;
+    Flexbox* m_rootFlexbox = nullptr;
+    QScopedPointer<ScrollViewModel> m_model;
+    QList<Flexbox*> m_rows;
+};
+
+void TestScrollViewWindow::initTestCase() {
+    // Items have no view manager to send onLayout events with
+    QLoggingCategory::setFilterRules("Flexbox.warning=false");
+}
+
+void TestScrollViewWindow::init() {
+    m_rootItem.reset(new QQuickItem());
+    m_rootFlexbox = new Flexbox(m_rootItem.data());
+    m_rootFlexbox->setControl(m_rootItem.data());
+
+    m_model.reset(new ScrollViewModel(nullptr));
+    m_model->setWindowed(true);
+    for (int i = 0; i < ROWS_COUNT; ++i) {
+        insertRow(createRow(), i);
+    }
+
+    // Rows are frozen after their first layout, the window then thaws the last two
+    layout();
+    m_model->setVisibleRange(ROWS_COUNT - 2, ROWS_COUNT - 1, 0);
+    layout();
+    QCOMPARE(row(ROWS_COUNT - 2)->y(), qreal((ROWS_COUNT - 2) * ROW_HEIGHT));
+}
+
+void TestScrollViewWindow::cleanup() {
+    m_model.reset();
+    m_rows.clear();
+    m_rootFlexbox = nullptr;
+    m_rootItem.reset();
+}
+
+Flexbox* TestScrollViewWindow::createRow() {
+    QQuickItem* item = new QQuickItem(m_rootItem.data());
+    Flexbox* flexbox = new Flexbox(item);
+    flexbox->setControl(item);
+    flexbox->setHeight(ROW_HEIGHT);
+    item->setProperty("flexbox", QVariant::fromValue(flexbox));
+    return flexbox;
+}
+
+void TestScrollViewWindow::insertRow(Flexbox* row, int position) {
+    m_rows.insert(position, row);
+    m_model->insert(row->control(), position);
+    m_rootFlexbox->updateChildren(QList<int>(), QList<int>{position}, QList<Flexbox*>{row});
+}
+
+void TestScrollViewWindow::moveRow(int from, int to) {
+    Flexbox* moved = m_rows.takeAt(from);
+    m_rows.insert(to, moved);
+    m_model->take(QList<int>{from});
+    m_model->insert(moved->control(), to);
+    m_rootFlexbox->updateChildren(QList<int>{from}, QList<int>{to}, QList<Flexbox*>{moved});
+}
+
+void TestScrollViewWindow::layout() {
+    m_rootFlexbox->recalculateLayout(ROW_WIDTH, ROWS_COUNT * ROW_HEIGHT);
+}
+
+QQuickItem* TestScrollViewWindow::row(int position) const {
+    return m_rows.at(position)->control();
+}
+
+void TestScrollViewWindow::testFrozenRowsKeepLayout() {
+    m_rows.at(2)->setHeight(RESIZED_ROW_HEIGHT);
+    layout();
+
+    // The placeholder of the frozen row keeps its last size
+    QCOMPARE(row(2)->height(), qreal(ROW_HEIGHT));
+    QCOMPARE(row(ROWS_COUNT - 2)->y(), qreal((ROWS_COUNT - 2) * ROW_HEIGHT));
+
+    m_model->setVisibleRange(2, ROWS_COUNT - 1, 0);
+    layout();
+    QCOMPARE(row(2)->height(), qreal(RESIZED_ROW_HEIGHT));
+    QCOMPARE(row(ROWS_COUNT - 2)->y(), qreal((ROWS_COUNT - 3) * ROW_HEIGHT + RESIZED_ROW_HEIGHT));
+}
+
+void TestScrollViewWindow::testInsertedRowFrozen() {
+    Flexbox* inserted = createRow();
+    insertRow(inserted, 5);
+
+    // Laid out once, so its placeholder has a size
+    layout();
+    QCOMPARE(inserted->control()->y(), qreal(5 * ROW_HEIGHT));
+    QCOMPARE(row(ROWS_COUNT - 1)->y(), qreal((ROWS_COUNT - 1) * ROW_HEIGHT));
+
+    inserted->setHeight(RESIZED_ROW_HEIGHT);
+    layout();
+    QCOMPARE(inserted->control()->height(), qreal(ROW_HEIGHT));
+    QCOMPARE(row(ROWS_COUNT - 1)->y(), qreal((ROWS_COUNT - 1) * ROW_HEIGHT));
+}
+
+void TestScrollViewWindow::testMovedRowFrozen() {
+    Flexbox* moved = m_rows.at(2);
+    moveRow(2, 7);
+    moved->setHeight(RESIZED_ROW_HEIGHT);
+    layout();
+
+    // Moved with its placeholder rather than attached unfrozen
+    QCOMPARE(moved->control()->height(), qreal(ROW_HEIGHT));
+    QCOMPARE(row(ROWS_COUNT - 2)->y(), qreal((ROWS_COUNT - 2) * ROW_HEIGHT));
+
+    m_model->setVisibleRange(7, ROWS_COUNT - 1, 0);
+    layout();
+    QCOMPARE(moved->control()->y(), qreal(7 * ROW_HEIGHT));
+    QCOMPARE(moved->control()->height(), qreal(RESIZED_ROW_HEIGHT));
+    QCOMPARE(row(ROWS_COUNT - 2)->y(), qreal(7 * ROW_HEIGHT + RESIZED_ROW_HEIGHT));
+}
+
+QTEST_MAIN(TestScrollViewWindow)
+#include "test-scrollview-window.moc"
@@ -0,0 +1,188 @@
+/**
+ * Copyright (c) 2017-present, Status Research and Development GmbH.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include <QDateTime>
+#include <QScopedPointer>
+#include <QTest>
+
+#include "timing.h"
+
+const int FRAME_TIMEOUT = 1000;
+
+// Records the calls Timing makes to JSTimers instead of sending them through a bridge
+class RecordingTiming : public Timing {
+public:
+    void createTimer(int timerId, int duration, bool repeats) {
+        QMetaObject::invokeMethod(this,
+                                  "createTimer",
+                                  Q_ARG(int, timerId),
+                                  Q_ARG(int, duration),
+                                  Q_ARG(QDateTime, QDateTime()),
+                                  Q_ARG(bool, repeats));
+    }
+    void deleteTimer(int timerId) {
+        QMetaObject::invokeMethod(this, "deleteTimer", Q_ARG(int, timerId));
+    }
+    void setSendIdleEvents(bool sendIdleEvents) {
+        QMetaObject::invokeMethod(this, "setSendIdleEvents", Q_ARG(bool, sendIdleEvents));
+    }
+
+    // Timer ids of each callTimers call
+    QList<QVariantList> timerCalls;
+    int idleCalls = 0;
+    bool jsIdle = true;
+
+protected:
+    void callJsTimers(const QString& method, const QVariantList& args) override {
+        if (method == "callTimers") {
+            timerCalls.push_back(args.first().toList());
+        } else if (method == "callIdleCallbacks") {
+            ++idleCalls;
+        }
+    }
+    bool isJsIdle() const override {
+        return jsIdle;
+    }
+};
+
+class TestTiming : public QObject {
+    Q_OBJECT
+
+private slots:
+    void init();
+    void cleanup();
+
+    void testImmediateTimersBatched();
+    void testEqualDeadlinesInCreationOrder();
+    void testEarlierDeadlineFirst();
+    void testRepeatingTimer();
+    void testDeletedTimerNotCalled();
+    void testIdleCallbacks();
+    void testIdleCallbacksWaitForDueTimers();
+    void testIdleCallbacksWaitForJs();
+
+private:
+    int timerCallCount(int timerId) const;
+
+    QScopedPointer<RecordingTiming> m_timing;
+};
+
+void TestTiming::init() {
+    m_timing.reset(new RecordingTiming());
+}
+
+void TestTiming::cleanup() {
+    m_timing.reset();
+}
+
+int TestTiming::timerCallCount(int timerId) const {
+    int count = 0;
+    for (const QVariantList& timerIds : m_timing->timerCalls) {
+        count += timerIds.count(timerId);
+    }
+    return count;
+}
+
+void TestTiming::testImmediateTimersBatched() {
+    m_timing->createTimer(1, 0, false);
+    m_timing->createTimer(2, 0, false);
+    m_timing->createTimer(3, 0, false);
+    m_timing->deleteTimer(2);
+
+    QTRY_COMPARE_WITH_TIMEOUT(m_timing->timerCalls.size(), 1, FRAME_TIMEOUT);
+    QCOMPARE(m_timing->timerCalls.first(), (QVariantList{1, 3}));
+}
+
+void TestTiming::testEqualDeadlinesInCreationOrder() {
+    // Timers due at the same time go to js in the order js created them, usually in one call
+    m_timing->createTimer(1, 50, false);
+    m_timing->createTimer(2, 50, false);
+    m_timing->createTimer(3, 50, false);
+
+    QTRY_COMPARE_WITH_TIMEOUT(timerCallCount(3), 1, FRAME_TIMEOUT);
+    QVariantList timerIds;
+    for (const QVariantList& call : m_timing->timerCalls) {
+        timerIds.append(call);
+    }
+    QCOMPARE(timerIds, (QVariantList{1, 2, 3}));
+}
+
+void TestTiming::testEarlierDeadlineFirst() {
+    m_timing->createTimer(1, 200, false);
+    m_timing->createTimer(2, 50, false);
+
+    QTRY_COMPARE_WITH_TIMEOUT(m_timing->timerCalls.size(), 2, FRAME_TIMEOUT);
+    QCOMPARE(m_timing->timerCalls.at(0), (QVariantList{2}));
+    QCOMPARE(m_timing->timerCalls.at(1), (QVariantList{1}));
+}
+
+void TestTiming::testRepeatingTimer() {
+    m_timing->createTimer(1, 30, true);
+    // Intervals shorter than a frame fire once per frame rather than in a loop
+    m_timing->createTimer(2, 1, true);
+
+    QTRY_VERIFY_WITH_TIMEOUT(timerCallCount(1) >= 3, FRAME_TIMEOUT);
+    QVERIFY(timerCallCount(2) > timerCallCount(1));
+    for (const QVariantList& timerIds : m_timing->timerCalls) {
+        QVERIFY(timerIds.count(2) <= 1);
+    }
+
+    m_timing->deleteTimer(1);
+    m_timing->deleteTimer(2);
+    const int callCount = m_timing->timerCalls.size();
+    QTest::qWait(100);
+    QCOMPARE(m_timing->timerCalls.size(), callCount);
+}
+
+void TestTiming::testDeletedTimerNotCalled() {
+    m_timing->createTimer(1, 30, false);
+    m_timing->createTimer(2, 30, false);
+    m_timing->deleteTimer(1);
+
+    QTRY_COMPARE_WITH_TIMEOUT(m_timing->timerCalls.size(), 1, FRAME_TIMEOUT);
+    QCOMPARE(m_timing->timerCalls.first(), (QVariantList{2}));
+}
+
+void TestTiming::testIdleCallbacks() {
+    m_timing->setSendIdleEvents(true);
+    QTRY_VERIFY_WITH_TIMEOUT(m_timing->idleCalls >= 2, FRAME_TIMEOUT);
+
+    m_timing->setSendIdleEvents(false);
+    QTest::qWait(50);
+    const int idleCalls = m_timing->idleCalls;
+    QTest::qWait(100);
+    QCOMPARE(m_timing->idleCalls, idleCalls);
+}
+
+void TestTiming::testIdleCallbacksWaitForDueTimers() {
+    // Due every frame, so no frame is left for idle callbacks
+    m_timing->createTimer(1, 1, true);
+    QTRY_VERIFY_WITH_TIMEOUT(timerCallCount(1) >= 1, FRAME_TIMEOUT);
+    m_timing->setSendIdleEvents(true);
+
+    QTRY_VERIFY_WITH_TIMEOUT(timerCallCount(1) >= 5, FRAME_TIMEOUT);
+    QCOMPARE(m_timing->idleCalls, 0);
+
+    m_timing->deleteTimer(1);
+    QTRY_VERIFY_WITH_TIMEOUT(m_timing->idleCalls > 0, FRAME_TIMEOUT);
+}
+
+void TestTiming::testIdleCallbacksWaitForJs() {
+    m_timing->jsIdle = false;
+    m_timing->setSendIdleEvents(true);
+    QTest::qWait(100);
+    QCOMPARE(m_timing->idleCalls, 0);
+
+    m_timing->jsIdle = true;
+    QTRY_VERIFY_WITH_TIMEOUT(m_timing->idleCalls > 0, FRAME_TIMEOUT);
+}
+
+QTEST_MAIN(TestTiming)
+#include "test-timing.moc"